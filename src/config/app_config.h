@@ -0,0 +1,96 @@
+#ifndef APP_CONFIG_H
+#define APP_CONFIG_H
+
+// Application Configuration
+// All values can be overridden from platformio.ini build_flags (-D NAME=value)
+
+// Run network and audio work in their own FreeRTOS tasks (Seeed_Arduino_FreeRTOS)
+// instead of blocking the UI loop. The UI loop stays the only caller of lv_*.
+#ifndef APP_USE_RTOS
+#define APP_USE_RTOS            0
+#endif
+
+// Task stacks (in words) and priorities; UI and network share a priority so
+// they time-slice even while the network code busy-waits
+#ifndef APP_UI_STACK
+#define APP_UI_STACK            2048
+#endif
+#ifndef APP_NET_STACK
+#define APP_NET_STACK           3072    // TLS handshakes need a deep stack
+#endif
+#ifndef APP_AUDIO_STACK
+#define APP_AUDIO_STACK         256
+#endif
+#define APP_UI_PRIORITY         1
+#define APP_NET_PRIORITY        1
+#define APP_AUDIO_PRIORITY      2
+
+// Grove speaker
+#define APP_SPEAKER_PIN         A0
+
+// Sleep the core (WFI) between loop passes instead of spinning in delay(),
+// and let input interrupts and worker results end the sleep early. With 0
+// the loop polls at the frame governor's rate as before (for comparison).
+#ifndef APP_IDLE_SLEEP
+#define APP_IDLE_SLEEP          1
+#endif
+
+// Input trace (record/replay of key events, see utils/InputTrace.h).
+// APP_TRACE_RECORD records from boot and keeps APP_TRACE_PATH on the SD card
+// up to date; APP_TRACE_REPLAY plays it back at boot (1 = real time, 2 = fast).
+#ifndef APP_TRACE_PATH
+#define APP_TRACE_PATH          "/input.trc"
+#endif
+#ifndef APP_TRACE_RECORD
+#define APP_TRACE_RECORD        0
+#endif
+#ifndef APP_TRACE_REPLAY
+#define APP_TRACE_REPLAY        0
+#endif
+#define APP_TRACE_SAVE_MS       10000
+
+// Page transition (PageManager::LoadAnim_t: 0 none, 1-4 over, 5-6 move,
+// 7 fade). Every frame of a transition redraws most of the screen, so keep
+// it short; DISP_BENCHMARK prints the frame rate of each type.
+#ifndef APP_PAGE_ANIM
+#define APP_PAGE_ANIM           5       // Move left
+#endif
+#ifndef APP_PAGE_ANIM_MS
+#define APP_PAGE_ANIM_MS        250
+#endif
+
+// Hidden pages keep their widgets so switching back is cheap. When less than
+// this much LVGL heap is free, the least recently shown hidden pages are
+// unloaded (onViewUnload) and rebuilt when shown again (0 = never unload).
+#ifndef APP_PAGE_UNLOAD_FREE
+#define APP_PAGE_UNLOAD_FREE    (12U * 1024U)
+#endif
+
+// Build the views of the pages left and right of the current one while the
+// UI is idle (one page per slice), so switching to them only has to show them
+#ifndef APP_PAGE_PRELOAD
+#define APP_PAGE_PRELOAD        1
+#endif
+
+// Line-based command console on the USB serial port (type "help")
+#ifndef APP_CONSOLE
+#define APP_CONSOLE             1
+#endif
+
+// Loop watchdog: UI loop passes longer than the budget are logged with the
+// page and subsystem that used the time
+#ifndef APP_LOOP_WATCHDOG
+#define APP_LOOP_WATCHDOG       1
+#endif
+#ifndef APP_LOOP_BUDGET_MS
+#define APP_LOOP_BUDGET_MS      100
+#endif
+
+// SAMD51 hardware watchdog fed by the UI loop; resets the board when a pass
+// takes longer than this (0 = off, max ~16000). Without APP_USE_RTOS the
+// WiFi connect runs inline and can take 15 s, so keep it near the maximum.
+#ifndef APP_HW_WATCHDOG_MS
+#define APP_HW_WATCHDOG_MS      0
+#endif
+
+#endif // APP_CONFIG_H
@@ -0,0 +1,143 @@
+#ifndef DISPLAY_CONFIG_H
+#define DISPLAY_CONFIG_H
+
+// Display Configuration
+// All values can be overridden from platformio.ini build_flags (-D NAME=value)
+
+// Panel resolution (landscape, rotation 3)
+#define DISP_HOR_RES            320
+#define DISP_VER_RES            240
+
+// LVGL draw buffer strategy
+#define DISP_BUF_SINGLE_SMALL   0       // One 10-line buffer (6.4 KB)
+#define DISP_BUF_DOUBLE_SMALL   1       // Two 10-line buffers, render while DMA sends (12.8 KB)
+#define DISP_BUF_DOUBLE_LARGE   2       // Two 40-line buffers (51.2 KB)
+#ifndef DISP_BUF_STRATEGY
+#define DISP_BUF_STRATEGY       DISP_BUF_DOUBLE_SMALL
+#endif
+
+#if DISP_BUF_STRATEGY == DISP_BUF_SINGLE_SMALL
+#define DISP_BUF_COUNT          1
+#define DISP_BUF_DEFAULT_LINES  10
+#elif DISP_BUF_STRATEGY == DISP_BUF_DOUBLE_SMALL
+#define DISP_BUF_COUNT          2
+#define DISP_BUF_DEFAULT_LINES  10
+#elif DISP_BUF_STRATEGY == DISP_BUF_DOUBLE_LARGE
+#define DISP_BUF_COUNT          2
+#define DISP_BUF_DEFAULT_LINES  40
+#else
+#error "Unknown DISP_BUF_STRATEGY"
+#endif
+
+// Height of one LVGL draw buffer in lines (overrides the strategy default)
+#ifndef DISP_BUF_LINES
+#define DISP_BUF_LINES          DISP_BUF_DEFAULT_LINES
+#endif
+#if DISP_BUF_LINES > DISP_VER_RES
+#error "DISP_BUF_LINES larger than the panel"
+#endif
+// The 192 KB of SRAM also hold the LVGL heap (48 KB), the task stacks and the
+// network buffers; more than the double-large strategy does not fit next to them
+#if defined(__SAMD51__) && DISP_BUF_COUNT * DISP_BUF_LINES * DISP_HOR_RES * 2 > 64 * 1024
+#error "LVGL draw buffers larger than 64 KB do not fit in the SAMD51 SRAM"
+#endif
+
+// Use SPI DMA for the flush; with two buffers LVGL renders into one while it runs
+// (falls back to blocking pushColors if the LCD driver can't start DMA)
+#ifndef DISP_USE_DMA
+#define DISP_USE_DMA            1
+#endif
+
+// Skip row spans whose pixels are unchanged since they were last sent
+// (one hash per row per DISP_HASH_BLOCK_W columns, 4 bytes each)
+#ifndef DISP_ROW_HASH
+#define DISP_ROW_HASH           1
+#endif
+#ifndef DISP_HASH_BLOCK_W
+#define DISP_HASH_BLOCK_W       64
+#endif
+// With DMA, unchanged spans are only skipped when at least this share (%) of
+// an area's blocks is unchanged: the spans go out with blocking writes, so
+// a mostly changed area is cheaper as one DMA transfer LVGL can render behind
+#ifndef DISP_HASH_MIN_SKIP_PCT
+#define DISP_HASH_MIN_SKIP_PCT  50
+#endif
+#define DISP_HASH_BLOCKS        ((DISP_HOR_RES + DISP_HASH_BLOCK_W - 1) / DISP_HASH_BLOCK_W)
+#if DISP_HASH_BLOCKS > 32
+#error "DISP_HASH_BLOCK_W too small: at most 32 blocks per row"
+#endif
+
+// Debug only: force a refresh pass every N ms on top of LVGL invalidation (0 = off)
+#ifndef DISP_FORCE_REFRESH_MS
+#define DISP_FORCE_REFRESH_MS   0
+#endif
+
+// Print refresh statistics every N ms (0 = off)
+#ifndef DISP_STATS_LOG_MS
+#define DISP_STATS_LOG_MS       30000
+#endif
+
+// Frame-rate governor: refresh period and loop sleep while animating vs. static
+#ifndef DISP_ACTIVE_REFR_PERIOD
+#define DISP_ACTIVE_REFR_PERIOD 10      // ms (~100 FPS cap)
+#endif
+#ifndef DISP_IDLE_REFR_PERIOD
+#define DISP_IDLE_REFR_PERIOD   200     // ms
+#endif
+#ifndef LOOP_ACTIVE_DELAY_MS
+#define LOOP_ACTIVE_DELAY_MS    5
+#endif
+#ifndef LOOP_IDLE_DELAY_MS
+#define LOOP_IDLE_DELAY_MS      20
+#endif
+#ifndef DISP_ACTIVE_HOLD_MS
+#define DISP_ACTIVE_HOLD_MS     500     // Stay fast this long after the last activity
+#endif
+
+// Per-frame render/flush profiler (ring buffer of the last N refreshes)
+#ifndef DISP_PROFILER
+#define DISP_PROFILER           1
+#endif
+#ifndef DISP_PROFILER_FRAMES
+#define DISP_PROFILER_FRAMES    128
+#endif
+
+// Input-to-flush latency histograms per page and per key
+#ifndef DISP_LATENCY_TRACKER
+#define DISP_LATENCY_TRACKER    1
+#endif
+
+// Draw the status and navigation bars from cached snapshots instead of
+// re-rendering their widgets on every overlapping refresh (44.8 KB heap)
+#ifndef DISP_CHROME_CACHE
+#define DISP_CHROME_CACHE       0
+#endif
+
+// Keep run-length encoded pictures of pages that were shown and draw them
+// while switching back, swapping the live widgets in after the first frame.
+// A page is pictured when it disappears, at most once per
+// DISP_SNAPSHOT_MIN_INTERVAL_MS. Pictures are evicted least recently used
+// first to stay within the budget (system heap bytes, including the buffers
+// a capture needs); a page whose picture needs more than
+// DISP_SNAPSHOT_MAX_BYTES is not cached. The budget comes out of the same
+// heap as the network task's TLS buffers, so keep it modest.
+#ifndef DISP_PAGE_SNAPSHOT
+#define DISP_PAGE_SNAPSHOT      1
+#endif
+#ifndef DISP_SNAPSHOT_BUDGET
+#define DISP_SNAPSHOT_BUDGET    (24U * 1024U)
+#endif
+#ifndef DISP_SNAPSHOT_MAX_BYTES
+#define DISP_SNAPSHOT_MAX_BYTES (12U * 1024U)
+#endif
+#ifndef DISP_SNAPSHOT_MIN_INTERVAL_MS
+#define DISP_SNAPSHOT_MIN_INTERVAL_MS 2000
+#endif
+#define DISP_SNAPSHOT_LINES     10      // Rows rendered per strip while capturing
+
+// Run the draw-buffer benchmark scenes once after setup (prints frame times and RAM)
+#ifndef DISP_BENCHMARK
+#define DISP_BENCHMARK          0
+#endif
+
+#endif // DISPLAY_CONFIG_H
@@ -1,5 +1,7 @@
 #include "AppManager.h"
 #include <Arduino.h>
+#include "../config/app_config.h"
+#include "TaskManager.h"
 #include "../utils/WiFiManager.h"
 #include "../pages/WeatherPage.h"
 
@@ -48,13 +50,11 @@ AppManager::~AppManager() {
 bool AppManager::init() {
     Serial.println("AppManager: Initializing X-TRACK style UI...");
 
-    // Initialize WiFi Manager
+    // Initialize WiFi Manager; connecting can take seconds, so it runs on
+    // the network task and the link state reaches the status bar as events
     Serial.println("AppManager: Initializing WiFi...");
-    WiFiManager& wifiMgr = WiFiManager::getInstance();
-    if (wifiMgr.begin()) {
-        Serial.println("AppManager: WiFi initialized successfully");
-    } else {
-        Serial.println("AppManager: WiFi initialization failed");
+    if (!Tasks.submit(TASK_NET, onWiFiBeginWork, onWiFiBeginDone, this, "wifi")) {
+        onWiFiBeginDone(this, onWiFiBeginWork(this));
     }
 
     // Create UI elements
@@ -64,7 +64,13 @@ bool AppManager::init() {
     registerPages();
 
     // Start with calendar page
+    pageManager.SetGlobalLoadAnimType((PageManager::LoadAnim_t)APP_PAGE_ANIM, APP_PAGE_ANIM_MS);
+    pageManager.SetUnloadThreshold(APP_PAGE_UNLOAD_FREE);
     pageManager.Push("Calendar");
+    preloadNeighbors();
+
+    // Periodic work for the visible page
+    Sched.every(1000, onUpdateJob, this, "app");
 
     Serial.println("AppManager: Initialized successfully");
     return true;
@@ -134,6 +140,12 @@ void AppManager::createUI() {
     createStatusBar();
     createNavigationBar();
 
+#if DISP_CHROME_CACHE
+    // The bars only change on page switches and status updates
+    statusCache.attach(statusBar);
+    navCache.attach(navBar);
+#endif
+
     Serial.println("AppManager: UI created successfully");
 }
 
@@ -209,6 +221,11 @@ void AppManager::createNavigationBar() {
 }
 
 void AppManager::updateNavigationBar() {
+#if DISP_CHROME_CACHE
+    // Draw the live bar while the indicator slides, re-cache when it stops
+    navCache.setLive(true);
+#endif
+
     // Update indicator position (X-TRACK style sliding animation)
     lv_anim_t a;
     lv_anim_init(&a);
@@ -217,6 +234,7 @@ void AppManager::updateNavigationBar() {
     lv_anim_set_time(&a, 200);
     lv_anim_set_exec_cb(&a, (lv_anim_exec_xcb_t)lv_obj_set_x);
     lv_anim_set_path_cb(&a, lv_anim_path_ease_out);
+    lv_anim_set_ready_cb(&a, onNavAnimReady);
     lv_anim_start(&a);
 
     // Update button states
@@ -246,19 +264,122 @@ void AppManager::updateNavigationBar() {
     Serial.printf("Navigation updated to index: %d\n", currentNavIndex);
 }
 
+void AppManager::onNavAnimReady(lv_anim_t* a) {
+    (void)a;
+#if DISP_CHROME_CACHE
+    if (instance) {
+        instance->navCache.setLive(false);
+    }
+#endif
+}
+
+void AppManager::updateStatusBar(const char* timeText, const char* batteryText) {
+    bool changed = false;
+
+    if (timeLabel && timeText && strcmp(lv_label_get_text(timeLabel), timeText) != 0) {
+        lv_label_set_text(timeLabel, timeText);
+        changed = true;
+    }
+    if (batteryLabel && batteryText && strcmp(lv_label_get_text(batteryLabel), batteryText) != 0) {
+        lv_label_set_text(batteryLabel, batteryText);
+        changed = true;
+    }
+
+#if DISP_CHROME_CACHE
+    if (changed) {
+        statusCache.update();
+    }
+#else
+    (void)changed;
+#endif
+}
+
+void AppManager::processEvents() {
+    // Bounded so a flapping link can't hold up the frame
+    WiFiLinkEvent event;
+    for (int i = 0; i < WIFI_EVENT_DEPTH && WiFiMgr.takeEvent(event); i++) {
+        onWiFiEvent(event);
+    }
+}
+
+void AppManager::onWiFiEvent(const WiFiLinkEvent& event) {
+    char text[32];
+
+    switch (event.state) {
+        case WIFI_LINK_UP:
+            Serial.printf("AppManager: WiFi up, IP %s, RSSI %d\n", event.ip, (int)event.rssi);
+            snprintf(text, sizeof(text), "%s %s 85%%", LV_SYMBOL_WIFI, LV_SYMBOL_BATTERY_3);
+            break;
+        case WIFI_LINK_CONNECTING:
+            snprintf(text, sizeof(text), "%s %s 85%%", LV_SYMBOL_REFRESH, LV_SYMBOL_BATTERY_3);
+            break;
+        default:
+            Serial.println("AppManager: WiFi down");
+            snprintf(text, sizeof(text), "%s 85%%", LV_SYMBOL_BATTERY_3);
+            break;
+    }
+    updateStatusBar(nullptr, text);
+}
+
+bool AppManager::onWiFiBeginWork(void* ctx) {
+    (void)ctx;
+    return WiFiMgr.begin();
+}
+
+void AppManager::onWiFiBeginDone(void* ctx, bool ok) {
+    (void)ctx;
+    if (ok) {
+        Serial.println("AppManager: WiFi initialized successfully");
+    } else {
+        Serial.println("AppManager: WiFi initialization failed");
+    }
+}
+
 void AppManager::switchToPage(int index) {
     if (index < 0 || index >= pageCount) return;
     if (index == currentNavIndex) return; // Already on this page
 
+    // Switch to corresponding page (all pages are now implemented); moving
+    // right plays the transition forwards, moving left plays it back.
+    // Refused while the previous transition is still running.
+    if (!pageManager.Replace(pageNames[index], index > currentNavIndex)) return;
+
     currentNavIndex = index;
     updateNavigationBar();
-
-    // Switch to corresponding page (all pages are now implemented)
-    pageManager.Replace(pageNames[index]);
+    preloadNeighbors();
 
     Serial.printf("Switched to page: %s\n", pageNames[index]);
 }
 
+void AppManager::preloadNeighbors() {
+#if APP_PAGE_PRELOAD
+    // Left/right on the joystick only ever moves to a neighbour
+    if (currentNavIndex > 0) {
+        pageManager.Preload(pageNames[currentNavIndex - 1]);
+    }
+    if (currentNavIndex < pageCount - 1) {
+        pageManager.Preload(pageNames[currentNavIndex + 1]);
+    }
+#endif
+}
+
+bool AppManager::showPage(const char* name) {
+    if (!name) return false;
+    for (int i = 0; i < pageCount; i++) {
+        if (strcasecmp(pageNames[i], name) == 0) {
+            switchToPage(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool AppManager::refreshWeather() {
+    if (!weatherPage) return false;
+    weatherPage->refreshWeather();
+    return true;
+}
+
 void AppManager::onNavButtonClick(lv_event_t* e) {
     int buttonIndex = (int)(intptr_t)lv_event_get_user_data(e);
     Serial.printf("AppManager: Nav button %d clicked\n", buttonIndex);
@@ -302,32 +423,8 @@ void AppManager::handleKeyA(bool pressed) {
 
     if (!pressed) return; // Only handle press, not release
 
-    // A button: ????????/??????
     PageBase* currentPage = pageManager.GetCurrentPage();
-    if (currentPage) {
-        const char* currentPageName = pageManager.GetCurrentPageName();
-        if (currentPageName) {
-            if (strcmp(currentPageName, "Alarm") == 0) {
-                // ????????????????????
-                currentPage->onKey(LV_DIR_BOTTOM);
-            } else if (strcmp(currentPageName, "Memo") == 0) {
-                // ??????????????????????
-                currentPage->onKey(LV_DIR_BOTTOM);
-            } else if (strcmp(currentPageName, "Music") == 0) {
-                // ????????????/???
-                static_cast<MusicPage*>(currentPage)->onButton(pressed);
-            } else if (strcmp(currentPageName, "Timer") == 0) {
-                // A???????/???
-                static_cast<TimerPage*>(currentPage)->onButtonA(pressed);
-            } else if (strcmp(currentPageName, "Weather") == 0) {
-                // A???????????
-                currentPage->onButton(pressed);
-            } else if (strcmp(currentPageName, "AI") == 0) {
-                // A?: AI??????/??
-                static_cast<AIAssistantPage*>(currentPage)->onButton(pressed);
-            }
-        }
-    }
+    if (currentPage) currentPage->onKeyA(pressed);
 }
 
 void AppManager::handleKeyB(bool pressed) {
@@ -335,35 +432,8 @@ void AppManager::handleKeyB(bool pressed) {
 
     if (!pressed) return; // Only handle press, not release
 
-    // B button: ??????/??????
     PageBase* currentPage = pageManager.GetCurrentPage();
-    if (currentPage) {
-        const char* currentPageName = pageManager.GetCurrentPageName();
-        if (currentPageName) {
-            if (strcmp(currentPageName, "Alarm") == 0) {
-                // ????????????????
-                AlarmPage* alarmPagePtr = static_cast<AlarmPage*>(currentPage);
-                alarmPagePtr->editMode = !alarmPagePtr->editMode;
-                alarmPagePtr->updateAlarmList();
-                Serial.printf("Alarm edit mode: %s\n", alarmPagePtr->editMode ? "ON" : "OFF");
-            } else if (strcmp(currentPageName, "Timer") == 0) {
-                // ???????????????
-                static_cast<TimerPage*>(currentPage)->onButtonB(true);
-            } else if (strcmp(currentPageName, "Memo") == 0) {
-                // ???????????????/????
-                static_cast<MemoPage*>(currentPage)->onButton(pressed);
-            } else if (strcmp(currentPageName, "Music") == 0) {
-                // ??????????????
-                currentPage->onKey(LV_DIR_RIGHT);
-            } else if (strcmp(currentPageName, "Weather") == 0) {
-                // B???????????????????????
-                Serial.println("Weather: Display mode switch not implemented yet");
-            } else if (strcmp(currentPageName, "AI") == 0) {
-                // B?: AI??????
-                static_cast<AIAssistantPage*>(currentPage)->onKey(LV_DIR_LEFT);
-            }
-        }
-    }
+    if (currentPage) currentPage->onKeyB(pressed);
 }
 
 void AppManager::handleKeyC(bool pressed) {
@@ -371,62 +441,24 @@ void AppManager::handleKeyC(bool pressed) {
 
     if (!pressed) return; // Only handle press, not release
 
-    // C button: ????/??????
     PageBase* currentPage = pageManager.GetCurrentPage();
-    if (currentPage) {
-        const char* currentPageName = pageManager.GetCurrentPageName();
-        if (currentPageName) {
-            if (strcmp(currentPageName, "Timer") == 0) {
-                // C???????????
-                static_cast<TimerPage*>(currentPage)->onButtonC(pressed);
-            } else if (strcmp(currentPageName, "Alarm") == 0) {
-                // ????????????????
-                static_cast<AlarmPage*>(currentPage)->onButton(pressed);
-            } else if (strcmp(currentPageName, "Music") == 0) {
-                // ??????????????
-                currentPage->onKey(LV_DIR_LEFT);
-            } else if (strcmp(currentPageName, "Memo") == 0) {
-                // ???????????????????
-                currentPage->onKey(LV_DIR_TOP);
-            } else if (strcmp(currentPageName, "Weather") == 0) {
-                // C?????????????????
-                Serial.println("Weather: Settings not implemented yet");
-            } else if (strcmp(currentPageName, "AI") == 0) {
-                // C?: AI??????
-                static_cast<AIAssistantPage*>(currentPage)->onKey(LV_DIR_RIGHT);
-            }
-        }
-    }
+    if (currentPage) currentPage->onKeyC(pressed);
 }
 
-void AppManager::update() {
-    // ??????Calendar??????????????????
-    if (calendarPage) {
-        calendarPage->update();
-    }
+bool AppManager::handleGesture(const Gesture& gesture) {
+    // Offered to the visible page first; plain presses it doesn't take
+    // fall back to the key handlers above
+    PageBase* currentPage = pageManager.GetCurrentPage();
+    return currentPage && currentPage->onGesture(gesture);
+}
+
+void AppManager::onUpdateJob(void* userData) {
+    static_cast<AppManager*>(userData)->update();
+}
 
-    // Periodic update for current page
+void AppManager::update() {
+    // Calendar, Timer, Music and Alarm run their own scheduler jobs;
+    // the others only need a tick while they are shown
     PageBase* currentPage = pageManager.GetCurrentPage();
-    if (currentPage) {
-        const char* currentPageName = pageManager.GetCurrentPageName();
-        if (currentPageName) {
-            if (strcmp(currentPageName, "Timer") == 0) {
-                // Update timer display
-                static_cast<TimerPage*>(currentPage)->updateTimer();
-            } else if (strcmp(currentPageName, "Alarm") == 0) {
-                // Check alarms
-                static_cast<AlarmPage*>(currentPage)->checkAlarms();
-            } else if (strcmp(currentPageName, "Music") == 0) {
-                // Update music playback progress
-                static_cast<MusicPage*>(currentPage)->updatePlaybackProgress();
-            } else if (strcmp(currentPageName, "Weather") == 0) {
-                // Update weather data
-                static_cast<WeatherPage*>(currentPage)->update();
-            } else if (strcmp(currentPageName, "AI") == 0) {
-                // Update AI assistant
-                static_cast<AIAssistantPage*>(currentPage)->update();
-            }
-            // Calendar????update?????????????????????????
-        }
-    }
+    if (currentPage) currentPage->onTick();
 }
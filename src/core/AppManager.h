@@ -1,6 +1,7 @@
 #pragma once
 
 #include "PageManager.h"
+#include "Scheduler.h"
 #include "../pages/CalendarPage.h"
 #include "../pages/MusicPage.h"
 #include "../pages/AlarmPage.h"
@@ -8,6 +9,8 @@
 #include "../pages/TimerPage.h"
 #include "../pages/WeatherPage.h"
 #include "../pages/AIAssistantPage.h"
+#include "../utils/CachedLayer.h"
+#include "../utils/WiFiManager.h"
 
 class AppManager {
 public:
@@ -21,7 +24,12 @@ public:
     void handleKeyA(bool pressed);
     void handleKeyB(bool pressed);
     void handleKeyC(bool pressed);
-    void update(); // Periodic update for timers and alarms
+    bool handleGesture(const Gesture& gesture);
+    void update(); // Periodic update for the visible page (1 s scheduler job)
+    void updateStatusBar(const char* timeText, const char* batteryText);
+    void processEvents(); // Drain messages posted by the worker tasks (UI loop)
+    bool showPage(const char* name); // Switch by page name (case-insensitive)
+    bool refreshWeather();
 
     PageManager* getPageManager() { return &pageManager; }
 
@@ -32,8 +40,14 @@ private:
     void createNavigationBar();
     void updateNavigationBar();
     void switchToPage(int index);
+    void preloadNeighbors();
 
     static void onNavButtonClick(lv_event_t* e);
+    static void onNavAnimReady(lv_anim_t* a);
+    static void onUpdateJob(void* userData);
+    static bool onWiFiBeginWork(void* ctx);
+    static void onWiFiBeginDone(void* ctx, bool ok);
+    void onWiFiEvent(const WiFiLinkEvent& event);
     static AppManager* instance; // For static callback
 
 private:
@@ -48,6 +62,12 @@ private:
     lv_obj_t* navLabels[7];
     lv_obj_t* navIndicator;
 
+#if DISP_CHROME_CACHE
+    // Pre-rendered status/navigation bars
+    CachedLayer statusCache;
+    CachedLayer navCache;
+#endif
+
     int currentNavIndex;
 
     // Pages
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <lvgl.h>
+#include "../utils/GestureEngine.h"
 
 class PageManager;
 
@@ -32,10 +33,15 @@ public:
     const char* _Name;            // Page name
     uint16_t _ID;                 // Page ID
     void* _UserData;              // User data pointer
+    GestureConfig _Gestures;      // Gestures wanted while the page is visible
 
     // Private data, only page manager access
     struct {
         State_t State;            // Page state
+        uint32_t LastShown;       // Switch count when last shown (LRU unload order)
+        bool IsReclaimed;         // View was unloaded to free memory, rebuilt on demand
+        uint32_t LoadBytes;       // LVGL heap taken by the last onViewLoad/onViewDidLoad
+        uint32_t CaptureMs;       // When it was last pictured on the way out (0 = never)
         
         // Animation state
         struct {
@@ -46,8 +52,12 @@ public:
     } priv;
 
 public:
-    PageBase() : _root(nullptr), _Manager(nullptr), _Name(nullptr), _ID(0), _UserData(nullptr) {
+    PageBase() : _root(nullptr), _Manager(nullptr), _Name(nullptr), _ID(0), _UserData(nullptr), _Gestures() {
         priv.State = PAGE_STATE_IDLE;
+        priv.LastShown = 0;
+        priv.IsReclaimed = false;
+        priv.LoadBytes = 0;
+        priv.CaptureMs = 0;
         priv.Anim.IsEnter = false;
         priv.Anim.IsBusy = false;
         priv.Anim.Attr.Type = 0;
@@ -71,4 +81,13 @@ public:
     virtual void onKey(lv_dir_t direction) {}
     virtual void onEncoder(int32_t diff) {}
     virtual void onButton(bool pressed) { (void)pressed; } // Default empty implementation
+    // Return true if the gesture was used; unused presses go the usual key route
+    virtual bool onGesture(const Gesture& gesture) { (void)gesture; return false; }
+    // Top keys A/B/C (called on press)
+    virtual void onKeyA(bool pressed) { (void)pressed; }
+    virtual void onKeyB(bool pressed) { (void)pressed; }
+    virtual void onKeyC(bool pressed) { (void)pressed; }
+
+    // Called every second while the page is visible
+    virtual void onTick() {}
 };
@@ -1,6 +1,16 @@
 #include "PageManager.h"
 #include <Arduino.h>
 #include <cstring>
+#include "../utils/DisplayManager.h"
+#include "../utils/FrameProfiler.h"
+#include "../utils/FrameGovernor.h"
+#include "../utils/LatencyTracker.h"
+
+// Longest a page picture stands in when no frame reaches the panel
+#define SNAPSHOT_SWAP_TIMEOUT_MS 100
+
+// How often the preload timer looks for an idle moment to build a page
+#define PRELOAD_STEP_MS 50
 
 PageManager::PageManager() {
     // Initialize page pool
@@ -8,6 +18,7 @@ PageManager::PageManager() {
         _PagePool[i] = nullptr;
     }
     _PagePoolSize = 0;
+    IndexRebuild();
 
     // Initialize page stack
     for (int i = 0; i < MAX_STACK_SIZE; i++) {
@@ -24,9 +35,38 @@ PageManager::PageManager() {
     _AnimState.Global.Type = LOAD_ANIM_OVER_LEFT;
     _AnimState.Global.Time = 500;
     _AnimState.Global.Path = lv_anim_path_ease_out;
+    _AnimState.StartMs = 0;
+    _AnimState.StartFrames = 0;
+    memset(_AnimStats, 0, sizeof(_AnimStats));
+
+    _ShowClock = 0;
+    _UnloadFree = 0;
+    memset(&_UnloadStats, 0, sizeof(_UnloadStats));
+    _UnloadStats.LowestFree = UINT32_MAX;
+
+    for (int i = 0; i < PAGE_PRELOAD_SLOTS; i++) {
+        _PreloadQueue[i] = nullptr;
+    }
+    _PreloadCount = 0;
+    _PreloadTimer = nullptr;
+    memset(&_PreloadStats, 0, sizeof(_PreloadStats));
+
+#if DISP_PAGE_SNAPSHOT
+    _SnapshotImg = nullptr;
+    _SnapshotPage = nullptr;
+    _SnapshotTimer = nullptr;
+    _SnapshotFrames = 0;
+    _SnapshotTick = 0;
+#endif
 }
 
 PageManager::~PageManager() {
+    if (_PreloadTimer) lv_timer_del(_PreloadTimer);
+#if DISP_PAGE_SNAPSHOT
+    if (_SnapshotTimer) lv_timer_del(_SnapshotTimer);
+    if (_SnapshotImg) lv_obj_del(_SnapshotImg);
+#endif
+
     // Clean up pages
     for (int i = 0; i < _PagePoolSize; i++) {
         if (_PagePool[i]) {
@@ -62,6 +102,8 @@ bool PageManager::Register(PageBase* page, const char* name) {
     page->_ID = _PagePoolSize;
 
     _PagePool[_PagePoolSize] = page;
+    _NameHash[_PagePoolSize] = HashName(name);
+    IndexInsert(_PagePoolSize);
     _PagePoolSize++;
 
     Serial.printf("Page '%s' registered (ID: %d)\n", name, page->_ID);
@@ -69,10 +111,21 @@ bool PageManager::Register(PageBase* page, const char* name) {
 }
 
 bool PageManager::Unregister(const char* name) {
+    if (_AnimState.IsBusy) {
+        Serial.println("Warning: Animation is busy, unregister refused");
+        return false;
+    }
+
     for (int i = 0; i < _PagePoolSize; i++) {
         if (_PagePool[i] && strcmp(_PagePool[i]->_Name, name) == 0) {
             PageBase* page = _PagePool[i];
 
+#if DISP_PAGE_SNAPSHOT
+            if (page == _SnapshotPage) SnapshotSwap();
+            _Snapshots.drop(page);
+#endif
+            CancelPreload();
+
             // Clean up if it's current page
             if (page == _PageCurrent) {
                 StateUnloadExecute(page);
@@ -88,9 +141,11 @@ bool PageManager::Unregister(const char* name) {
             // Shift remaining pages
             for (int j = i; j < _PagePoolSize - 1; j++) {
                 _PagePool[j] = _PagePool[j + 1];
+                _NameHash[j] = _NameHash[j + 1];
             }
             _PagePool[_PagePoolSize - 1] = nullptr;
             _PagePoolSize--;
+            IndexRebuild();
 
             Serial.printf("Page '%s' unregistered\n", name);
             return true;
@@ -134,7 +189,7 @@ bool PageManager::Pop() {
     return SwitchTo(prevPage, false);
 }
 
-bool PageManager::Replace(const char* name) {
+bool PageManager::Replace(const char* name, bool isEnterAct) {
     Serial.printf("PageManager::Replace called with name: %s\n", name);
     PageBase* page = FindPageInPool(name);
     if (!page) {
@@ -151,7 +206,7 @@ bool PageManager::Replace(const char* name) {
     Serial.printf("Replacing with page: %s\n", name);
 
     // Don't push to stack, just replace
-    bool result = SwitchTo(page, true);
+    bool result = SwitchTo(page, isEnterAct);
     Serial.printf("SwitchTo result: %d\n", result);
     return result;
 }
@@ -210,14 +265,51 @@ const char* PageManager::GetCurrentPageName() {
 }
 
 PageBase* PageManager::FindPageInPool(const char* name) {
-    for (int i = 0; i < _PagePoolSize; i++) {
-        if (_PagePool[i] && strcmp(_PagePool[i]->_Name, name) == 0) {
-            return _PagePool[i];
+    if (!name) return nullptr;
+
+    uint32_t hash = HashName(name);
+    for (int probe = 0; probe < PAGE_NAME_SLOTS; probe++) {
+        int8_t index = _NameIndex[(hash + probe) & (PAGE_NAME_SLOTS - 1)];
+        if (index < 0) break;
+
+        PageBase* page = _PagePool[index];
+        // Callers usually pass the same string the page was registered with
+        if (_NameHash[index] == hash && (page->_Name == name || strcmp(page->_Name, name) == 0)) {
+            return page;
         }
     }
     return nullptr;
 }
 
+uint32_t PageManager::HashName(const char* name) {
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    while (*name) {
+        hash = (hash ^ (uint8_t)*name++) * 16777619u;
+    }
+    return hash;
+}
+
+void PageManager::IndexInsert(int poolIndex) {
+    uint32_t hash = _NameHash[poolIndex];
+    for (int probe = 0; probe < PAGE_NAME_SLOTS; probe++) {
+        int8_t& slot = _NameIndex[(hash + probe) & (PAGE_NAME_SLOTS - 1)];
+        if (slot < 0) {
+            slot = poolIndex;
+            return;
+        }
+    }
+}
+
+void PageManager::IndexRebuild() {
+    for (int i = 0; i < PAGE_NAME_SLOTS; i++) {
+        _NameIndex[i] = -1;
+    }
+    for (int i = 0; i < _PagePoolSize; i++) {
+        IndexInsert(i);
+    }
+}
+
 PageBase* PageManager::GetStackTop() {
     return (_StackTop >= 0) ? _PageStack[_StackTop] : nullptr;
 }
@@ -249,44 +341,503 @@ bool PageManager::SwitchTo(PageBase* page, bool isEnterAct) {
         return false;
     }
 
+    // Queued for the old neighbourhood; the caller queues the new one
+    CancelPreload();
+
+#if DISP_PAGE_SNAPSHOT
+    // A picture still standing in for the current page makes way first
+    SnapshotSwap();
+#endif
+
     Serial.printf("Switching to page: %s (enter=%d)\n", page->_Name, isEnterAct);
 
     _PagePrev = _PageCurrent;
     _PageCurrent = page;
     _AnimState.IsEntering = isEnterAct;
 
+    bool hasPrev = _PagePrev && _PagePrev != _PageCurrent;
+
     // Handle previous page
-    if (_PagePrev && _PagePrev != _PageCurrent) {
+    if (hasPrev) {
+#if DISP_PAGE_SNAPSHOT
+        // Taken as it looks now, before the animation moves it; stands in
+        // for it when it comes back
+        SnapshotCapture(_PagePrev);
+#endif
         StateWillDisappearExecute(_PagePrev);
     }
 
     // Handle current page
-    if (_PageCurrent->priv.State == PageBase::PAGE_STATE_IDLE) {
+    if (_PageCurrent->priv.State == PageBase::PAGE_STATE_LOAD) {
+        _PreloadStats.Used++;   // Built ahead of time, only needs to appear
+    } else if (_PageCurrent->priv.State == PageBase::PAGE_STATE_IDLE) {
+        if (_PageCurrent->priv.IsReclaimed) {
+            _PageCurrent->priv.IsReclaimed = false;
+            _UnloadStats.Rebuilds++;
+        }
+        // Make room for the new widget tree first
+        ReclaimMemory();
         StateLoadExecute(_PageCurrent);
     }
 
     StateWillAppearExecute(_PageCurrent);
+
+#if DISP_PAGE_SNAPSHOT
+    bool snapshotShown = hasPrev && SnapshotShow(_PageCurrent);
+#endif
+
+    // Animate both roots; the Did* callbacks run once the animation ends
+    uint8_t type = _AnimState.Global.Type;
+    if (hasPrev && _PagePrev->_root && _PageCurrent->_root &&
+        type != LOAD_ANIM_NONE && type < _LOAD_ANIM_LAST && _AnimState.Global.Time > 0) {
+        _AnimState.IsBusy = true;
+        _AnimState.StartMs = millis();
+        _AnimState.StartFrames = DisplayMgr.getRefreshStats().flushedPasses;
+
+        _PageCurrent->priv.Anim.IsEnter = true;
+        _PagePrev->priv.Anim.IsEnter = false;
+        SwitchAnimCreate(_PageCurrent);
+        SwitchAnimCreate(_PagePrev);
+
+        if (!_PageCurrent->priv.Anim.IsBusy && !_PagePrev->priv.Anim.IsBusy) {
+            SwitchAnimFinish();
+        }
+        return true;
+    }
+
     StateDidAppearExecute(_PageCurrent);
 
     // Handle previous page cleanup
-    if (_PagePrev && _PagePrev != _PageCurrent) {
+    if (hasPrev) {
         StateDidDisappearExecute(_PagePrev);
     }
 
+    ReclaimMemory();
+
+#if DISP_PAGE_SNAPSHOT
+    // Swap the live root in once the picture has reached the panel
+    if (snapshotShown) {
+        _SnapshotFrames = DisplayMgr.getRefreshStats().flushedPasses;
+        _SnapshotTick = lv_tick_get();
+        _SnapshotTimer = lv_timer_create(onSnapshotTimer, 0, this);
+    }
+#endif
+
     return true;
 }
 
-void PageManager::onSwitchAnimFinish(lv_anim_t* a) {
-    PageManager* manager = (PageManager*)a->user_data;
-    if (manager) {
-        manager->_AnimState.IsBusy = false;
-        Serial.println("Switch animation finished");
+// Start and end value of one page's part in a transition
+struct AnimVect {
+    int32_t Start;
+    int32_t End;
+};
+
+// What a transition type animates, for both pages, forwards (push) and back (pop)
+struct AnimPath {
+    lv_anim_exec_xcb_t Setter;
+    AnimVect PushEnter;
+    AnimVect PushExit;
+    AnimVect PopEnter;
+    AnimVect PopExit;
+};
+
+static void SetRootOpa(void* obj, int32_t opa) {
+    lv_obj_set_style_opa((lv_obj_t*)obj, (lv_opa_t)opa, 0);
+}
+
+static bool GetAnimPath(uint8_t type, AnimPath* path) {
+    const int32_t w = LV_HOR_RES;
+    const int32_t h = LV_VER_RES;
+
+    switch (type) {
+        case PageManager::LOAD_ANIM_OVER_LEFT:
+            *path = {(lv_anim_exec_xcb_t)lv_obj_set_x, {w, 0}, {0, 0}, {0, 0}, {0, w}};
+            return true;
+        case PageManager::LOAD_ANIM_OVER_RIGHT:
+            *path = {(lv_anim_exec_xcb_t)lv_obj_set_x, {-w, 0}, {0, 0}, {0, 0}, {0, -w}};
+            return true;
+        case PageManager::LOAD_ANIM_OVER_TOP:
+            *path = {(lv_anim_exec_xcb_t)lv_obj_set_y, {-h, 0}, {0, 0}, {0, 0}, {0, -h}};
+            return true;
+        case PageManager::LOAD_ANIM_OVER_BOTTOM:
+            *path = {(lv_anim_exec_xcb_t)lv_obj_set_y, {h, 0}, {0, 0}, {0, 0}, {0, h}};
+            return true;
+        case PageManager::LOAD_ANIM_MOVE_LEFT:
+            *path = {(lv_anim_exec_xcb_t)lv_obj_set_x, {w, 0}, {0, -w}, {-w, 0}, {0, w}};
+            return true;
+        case PageManager::LOAD_ANIM_MOVE_RIGHT:
+            *path = {(lv_anim_exec_xcb_t)lv_obj_set_x, {-w, 0}, {0, w}, {w, 0}, {0, -w}};
+            return true;
+        case PageManager::LOAD_ANIM_FADE_ON:
+            *path = {SetRootOpa, {LV_OPA_TRANSP, LV_OPA_COVER}, {LV_OPA_COVER, LV_OPA_COVER},
+                     {LV_OPA_COVER, LV_OPA_COVER}, {LV_OPA_COVER, LV_OPA_TRANSP}};
+            return true;
+        default:
+            return false;
     }
 }
 
+void PageManager::onSwitchAnimFinish(lv_anim_t* a) {
+    PageBase* page = (PageBase*)a->user_data;
+    if (!page || !page->_Manager) return;
+
+    page->priv.Anim.IsBusy = false;
+
+    // Both pages have to be in place before the lifecycle moves on
+    PageManager* manager = page->_Manager;
+    if (manager->_PageCurrent && manager->_PageCurrent->priv.Anim.IsBusy) return;
+    if (manager->_PagePrev && manager->_PagePrev->priv.Anim.IsBusy) return;
+
+    manager->SwitchAnimFinish();
+}
+
 void PageManager::SwitchAnimCreate(PageBase* page) {
-    // Simple implementation - just mark as not busy
+    page->priv.Anim.Attr = _AnimState.Global;
+    page->priv.Anim.IsBusy = false;
+
+    AnimPath path;
+    if (!GetAnimPath(page->priv.Anim.Attr.Type, &path)) return;
+
+    const AnimVect& vect = _AnimState.IsEntering
+        ? (page->priv.Anim.IsEnter ? path.PushEnter : path.PushExit)
+        : (page->priv.Anim.IsEnter ? path.PopEnter : path.PopExit);
+
+    // A page that stays put costs nothing per frame, so it gets no animation
+    if (vect.Start == vect.End) return;
+
+    lv_obj_t* target = GetAnimTarget(page);
+
+    // Going back, the leaving page slides or fades out above the returning one
+    if (!_AnimState.IsEntering && !page->priv.Anim.IsEnter) {
+        lv_obj_move_foreground(target);
+    }
+
+    page->priv.Anim.IsBusy = true;
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, target);
+    lv_anim_set_values(&a, vect.Start, vect.End);
+    lv_anim_set_time(&a, page->priv.Anim.Attr.Time);
+    lv_anim_set_path_cb(&a, page->priv.Anim.Attr.Path);
+    lv_anim_set_exec_cb(&a, path.Setter);
+    lv_anim_set_ready_cb(&a, onSwitchAnimFinish);
+    a.user_data = page;
+    lv_anim_start(&a);
+}
+
+void PageManager::SwitchAnimFinish() {
+    uint32_t ms = millis() - _AnimState.StartMs;
+    uint32_t frames = DisplayMgr.getRefreshStats().flushedPasses - _AnimState.StartFrames;
+    uint8_t type = _PageCurrent->priv.Anim.Attr.Type;
+    if (type < _LOAD_ANIM_LAST) {
+        AnimStats& stats = _AnimStats[type];
+        uint16_t fps = ms ? (uint16_t)(frames * 1000 / ms) : 0;
+        if (stats.Runs == 0 || fps < stats.MinFps) stats.MinFps = fps;
+        stats.Runs++;
+        stats.Frames += frames;
+        stats.Ms += ms;
+    }
+
     _AnimState.IsBusy = false;
+
+#if DISP_PAGE_SNAPSHOT
+    SnapshotSwap();
+#endif
+
+    StateDidAppearExecute(_PageCurrent);
+
+    if (_PagePrev && _PagePrev != _PageCurrent) {
+        StateDidDisappearExecute(_PagePrev);
+
+        // Park the hidden root where the next transition expects it
+        if (_PagePrev->_root) {
+            lv_obj_set_pos(_PagePrev->_root, 0, 0);
+            lv_obj_set_style_opa(_PagePrev->_root, LV_OPA_COVER, 0);
+        }
+    }
+
+    ReclaimMemory();
+}
+
+void PageManager::ReclaimMemory() {
+    if (_UnloadFree == 0 || _AnimState.IsBusy) return;
+
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    if (mon.total_size == 0) return; // Custom allocator, no figures to go by
+    if (mon.free_size < _UnloadStats.LowestFree) _UnloadStats.LowestFree = mon.free_size;
+    if (mon.free_size >= _UnloadFree) return;
+
+    _UnloadStats.Triggers++;
+    while (mon.free_size < _UnloadFree) {
+        PageBase* page = FindUnloadCandidate();
+        if (!page) {
+            _UnloadStats.Starved++;
+            Serial.printf("PageManager: heap low (%lu free), no hidden page to unload\n",
+                          (unsigned long)mon.free_size);
+            return;
+        }
+
+        Serial.printf("PageManager: heap low (%lu free), unloading %s\n",
+                      (unsigned long)mon.free_size, page->_Name);
+        StateUnloadExecute(page);
+        page->priv.IsReclaimed = true;
+        _UnloadStats.Unloads++;
+
+        lv_mem_monitor(&mon);
+    }
+}
+
+PageBase* PageManager::FindUnloadCandidate() {
+    PageBase* oldest = nullptr;
+
+    for (int i = 0; i < _PagePoolSize; i++) {
+        PageBase* page = _PagePool[i];
+        if (!page || page == _PageCurrent || !page->_root) continue;
+        if (page->priv.Anim.IsBusy) continue;
+        // Hidden after being shown, or built ahead of time and not shown yet
+        if (page->priv.State != PageBase::PAGE_STATE_DID_DISAPPEAR &&
+            page->priv.State != PageBase::PAGE_STATE_LOAD) continue;
+
+        // Stacked pages come back with Pop() and keep their views
+        bool stacked = false;
+        for (int j = 0; j <= _StackTop; j++) {
+            if (_PageStack[j] == page) {
+                stacked = true;
+                break;
+            }
+        }
+        if (stacked) continue;
+
+        if (!oldest || page->priv.LastShown < oldest->priv.LastShown) {
+            oldest = page;
+        }
+    }
+
+    return oldest;
+}
+
+bool PageManager::Preload(const char* name) {
+    PageBase* page = FindPageInPool(name);
+    if (!page || page == _PageCurrent) return false;
+    if (page->priv.State != PageBase::PAGE_STATE_IDLE) return false; // Already built
+
+    for (int i = 0; i < _PreloadCount; i++) {
+        if (_PreloadQueue[i] == page) return true;
+    }
+    if (_PreloadCount >= PAGE_PRELOAD_SLOTS) return false;
+
+    _PreloadQueue[_PreloadCount++] = page;
+    if (!_PreloadTimer) {
+        _PreloadTimer = lv_timer_create(onPreloadTimer, PRELOAD_STEP_MS, this);
+    }
+    return true;
+}
+
+void PageManager::CancelPreload() {
+    for (int i = 0; i < _PreloadCount; i++) {
+        _PreloadQueue[i] = nullptr;
+    }
+    _PreloadCount = 0;
+
+    if (_PreloadTimer) {
+        lv_timer_del(_PreloadTimer);
+        _PreloadTimer = nullptr;
+    }
+}
+
+void PageManager::onPreloadTimer(lv_timer_t* timer) {
+    PageManager* manager = (PageManager*)timer->user_data;
+    manager->PreloadStep();
+}
+
+void PageManager::PreloadStep() {
+    // Only once the screen has settled: no transition, no picture standing
+    // in, and no input or animation for a while (the frame governor idles)
+    if (_AnimState.IsBusy || FrameGov.isActive()) return;
+    if (!_PageCurrent || _PageCurrent->priv.State != PageBase::PAGE_STATE_ACTIVITY) return;
+#if DISP_PAGE_SNAPSHOT
+    if (_SnapshotPage) return;
+#endif
+
+    // One page per slice; the loop handles input and frames in between
+    PageBase* page = _PreloadQueue[0];
+    for (int i = 1; i < _PreloadCount; i++) {
+        _PreloadQueue[i - 1] = _PreloadQueue[i];
+    }
+    _PreloadQueue[--_PreloadCount] = nullptr;
+    if (_PreloadCount == 0) {
+        lv_timer_del(_PreloadTimer);
+        _PreloadTimer = nullptr;
+    }
+
+    if (page->priv.State != PageBase::PAGE_STATE_IDLE) return;
+
+    // Never go below the unload threshold: that would only unload another page
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    if (_UnloadFree && mon.total_size && mon.free_size < _UnloadFree + page->priv.LoadBytes) {
+        _PreloadStats.NoRoom++;
+        return;
+    }
+
+    uint32_t startUs = micros();
+    StateLoadExecute(page);
+    uint32_t us = micros() - startUs;
+
+    // Ranks with the current page for unloading
+    page->priv.LastShown = _ShowClock;
+
+    _PreloadStats.Built++;
+    _PreloadStats.TotalUs += us;
+    if (us > _PreloadStats.MaxUs) _PreloadStats.MaxUs = us;
+    Serial.printf("PageManager: preloaded %s in %lu us (%lu bytes)\n",
+                  page->_Name, (unsigned long)us, (unsigned long)page->priv.LoadBytes);
+
+    // First build of this page was bigger than the room left
+    lv_mem_monitor(&mon);
+    if (_UnloadFree && mon.total_size && mon.free_size < _UnloadFree) {
+        StateUnloadExecute(page);
+        _PreloadStats.Dropped++;
+    }
+}
+
+void PageManager::PrintPreloadStats() {
+    uint32_t avgUs = _PreloadStats.Built ? _PreloadStats.TotalUs / _PreloadStats.Built : 0;
+    Serial.printf("PageManager: preload %lu built, %lu used, %lu no room, %lu dropped, "
+                  "slice avg %lu us, max %lu us\n",
+                  (unsigned long)_PreloadStats.Built, (unsigned long)_PreloadStats.Used,
+                  (unsigned long)_PreloadStats.NoRoom, (unsigned long)_PreloadStats.Dropped,
+                  (unsigned long)avgUs, (unsigned long)_PreloadStats.MaxUs);
+}
+
+void PageManager::PrintUnloadStats() {
+    if (_UnloadFree == 0) {
+        Serial.println("PageManager: page unloading off");
+        return;
+    }
+
+    Serial.printf("PageManager: unload below %lu free: %lu triggers, %lu pages unloaded, "
+                  "%lu rebuilt, %lu with nothing to unload\n",
+                  (unsigned long)_UnloadFree, (unsigned long)_UnloadStats.Triggers,
+                  (unsigned long)_UnloadStats.Unloads, (unsigned long)_UnloadStats.Rebuilds,
+                  (unsigned long)_UnloadStats.Starved);
+    if (_UnloadStats.LowestFree != UINT32_MAX) {
+        Serial.printf("PageManager: lowest free heap seen at a page switch: %lu bytes\n",
+                      (unsigned long)_UnloadStats.LowestFree);
+    }
+}
+
+lv_obj_t* PageManager::GetAnimTarget(PageBase* page) {
+#if DISP_PAGE_SNAPSHOT
+    if (page == _SnapshotPage) return _SnapshotImg;
+#endif
+    return page->_root;
+}
+
+#if DISP_PAGE_SNAPSHOT
+bool PageManager::SnapshotShow(PageBase* page) {
+    if (!page->_root) return false;
+
+    const lv_img_dsc_t* picture = _Snapshots.get(page);
+    if (!picture) return false;
+
+    if (!_SnapshotImg) {
+        _SnapshotImg = lv_img_create(lv_obj_get_parent(page->_root));
+        lv_obj_clear_flag(_SnapshotImg, LV_OBJ_FLAG_CLICKABLE);
+    }
+    lv_img_set_src(_SnapshotImg, picture);
+    lv_obj_set_pos(_SnapshotImg, lv_obj_get_x(page->_root), lv_obj_get_y(page->_root));
+    lv_obj_set_style_opa(_SnapshotImg, LV_OPA_COVER, 0);
+    lv_obj_clear_flag(_SnapshotImg, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_move_foreground(_SnapshotImg);
+
+    // Hidden objects are skipped by the renderer
+    lv_obj_add_flag(page->_root, LV_OBJ_FLAG_HIDDEN);
+    _SnapshotPage = page;
+    return true;
+}
+
+void PageManager::SnapshotSwap() {
+    if (_SnapshotTimer) {
+        lv_timer_del(_SnapshotTimer);
+        _SnapshotTimer = nullptr;
+    }
+    if (!_SnapshotPage) return;
+
+    if (_SnapshotPage->_root) {
+        lv_obj_clear_flag(_SnapshotPage->_root, LV_OBJ_FLAG_HIDDEN);
+    }
+    lv_obj_add_flag(_SnapshotImg, LV_OBJ_FLAG_HIDDEN);
+    _SnapshotPage = nullptr;
+}
+
+void PageManager::SnapshotCapture(PageBase* page) {
+    if (!page->_root || page->priv.State != PageBase::PAGE_STATE_ACTIVITY) {
+        _Snapshots.drop(page);
+        return;
+    }
+
+    // Rendering a page in software delays the switch; a page that is left
+    // again soon (fast browsing, or one that redraws all the time) keeps
+    // its recent picture, at most DISP_SNAPSHOT_MIN_INTERVAL_MS old, which
+    // is only on screen until the first live frame
+    uint32_t now = millis();
+    if (page->priv.CaptureMs && now - page->priv.CaptureMs < DISP_SNAPSHOT_MIN_INTERVAL_MS) return;
+
+    // Also stamped when the page did not fit, so it is not rendered again
+    // on every switch
+    _Snapshots.capture(page, page->_root);
+    page->priv.CaptureMs = now ? now : 1;
+}
+
+void PageManager::onSnapshotTimer(lv_timer_t* timer) {
+    PageManager* manager = (PageManager*)timer->user_data;
+
+    // Wait for a flushed frame; give up waiting if nothing reached the panel
+    bool flushed = DisplayMgr.getRefreshStats().flushedPasses != manager->_SnapshotFrames;
+    if (!flushed && lv_tick_elaps(manager->_SnapshotTick) < SNAPSHOT_SWAP_TIMEOUT_MS) return;
+
+    manager->SnapshotSwap();
+}
+#endif
+
+void PageManager::SetSnapshotBudget(uint32_t bytes) {
+#if DISP_PAGE_SNAPSHOT
+    _Snapshots.setBudget(bytes);
+#else
+    (void)bytes;
+#endif
+}
+
+void PageManager::PrintSnapshotStats() {
+#if DISP_PAGE_SNAPSHOT
+    _Snapshots.printStats();
+#endif
+}
+
+void PageManager::PrintAnimStats() {
+    static const char* const names[_LOAD_ANIM_LAST] = {
+        "none", "over left", "over right", "over top", "over bottom",
+        "move left", "move right", "fade on"
+    };
+
+    bool any = false;
+    for (int type = LOAD_ANIM_NONE + 1; type < _LOAD_ANIM_LAST; type++) {
+        const AnimStats& stats = _AnimStats[type];
+        if (stats.Runs == 0) continue;
+
+        uint32_t fps10 = stats.Ms ? stats.Frames * 10000 / stats.Ms : 0;
+        Serial.printf("PageManager: anim %-11s %4u runs, %lu.%lu FPS avg, %u FPS min\n",
+                      names[type], stats.Runs,
+                      (unsigned long)(fps10 / 10), (unsigned long)(fps10 % 10),
+                      stats.MinFps);
+        any = true;
+    }
+    if (!any) {
+        Serial.println("PageManager: no page transitions yet");
+    }
 }
 
 PageBase::State_t PageManager::StateLoadExecute(PageBase* page) {
@@ -296,9 +847,15 @@ PageBase::State_t PageManager::StateLoadExecute(PageBase* page) {
 
     page->priv.State = PageBase::PAGE_STATE_LOAD;
 
-    // Create root object if not exists
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    uint32_t freeBefore = mon.free_size;
+
+    // Create root object if not exists; hidden until it appears, so
+    // building the widgets invalidates nothing
     if (!page->_root) {
         page->_root = lv_obj_create(lv_scr_act());
+        lv_obj_add_flag(page->_root, LV_OBJ_FLAG_HIDDEN);
         lv_obj_set_size(page->_root, LV_HOR_RES, LV_VER_RES);
         lv_obj_align(page->_root, LV_ALIGN_CENTER, 0, 0);
         lv_obj_clear_flag(page->_root, LV_OBJ_FLAG_SCROLLABLE);
@@ -307,6 +864,9 @@ PageBase::State_t PageManager::StateLoadExecute(PageBase* page) {
     page->onViewLoad();
     page->onViewDidLoad();
 
+    lv_mem_monitor(&mon);
+    page->priv.LoadBytes = freeBefore > mon.free_size ? freeBefore - mon.free_size : 0;
+
     return page->priv.State;
 }
 
@@ -316,6 +876,12 @@ PageBase::State_t PageManager::StateWillAppearExecute(PageBase* page) {
     Serial.printf("Page will appear: %s\n", page->_Name);
 
     page->priv.State = PageBase::PAGE_STATE_WILL_APPEAR;
+    page->priv.LastShown = ++_ShowClock;
+    FrameProf.setTag(page->_ID, page->_Name);
+#if DISP_LATENCY_TRACKER
+    LatencyTrk.setPage(page->_ID, page->_Name);
+#endif
+    Gestures.setConfig(&page->_Gestures);
     page->onViewWillAppear();
 
     // Show the page
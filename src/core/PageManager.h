@@ -1,9 +1,12 @@
 #pragma once
 
 #include "PageBase.h"
+#include "../utils/SnapshotCache.h"
 
 #define MAX_PAGES 10
 #define MAX_STACK_SIZE 10
+#define PAGE_NAME_SLOTS 16  // Name index slots (power of two, > MAX_PAGES)
+#define PAGE_PRELOAD_SLOTS 4
 
 class PageManager {
 public:
@@ -31,11 +34,32 @@ public:
     // Navigation
     bool Push(const char* name);
     bool Pop();
-    bool Replace(const char* name);
+    bool Replace(const char* name, bool isEnterAct = true);
     bool BackHome();
     
     // Animation
     void SetGlobalLoadAnimType(LoadAnim_t anim = LOAD_ANIM_OVER_LEFT, uint16_t time = 500);
+    LoadAnim_t GetGlobalLoadAnimType() const { return (LoadAnim_t)_AnimState.Global.Type; }
+    uint16_t GetGlobalLoadAnimTime() const { return _AnimState.Global.Time; }
+    bool IsAnimBusy() const { return _AnimState.IsBusy; }
+    void PrintAnimStats();
+
+    // Pictures of pages shown before, drawn while switching back to them
+    void SetSnapshotBudget(uint32_t bytes);
+    void PrintSnapshotStats();
+
+    // Unload least recently shown hidden pages while less than freeBytes of
+    // the LVGL heap are free (0 = keep every page loaded)
+    void SetUnloadThreshold(uint32_t freeBytes) { _UnloadFree = freeBytes; }
+    uint32_t GetUnloadThreshold() const { return _UnloadFree; }
+    void PrintUnloadStats();
+
+    // Build a hidden page's view ahead of time, one page per idle slice, as
+    // long as the heap stays above the unload threshold. Switching pages
+    // drops what is still queued.
+    bool Preload(const char* name);
+    void CancelPreload();
+    void PrintPreloadStats();
     
     // Input handling
     void HandleInput(lv_dir_t direction);
@@ -46,9 +70,18 @@ public:
     const char* GetCurrentPageName();
     PageBase* GetCurrentPage() { return _PageCurrent; }
 
+    // Introspection: pages stacked below the current one, and all registered pages
+    int GetStackDepth() const { return _StackTop + 1; }
+    PageBase* GetStackPage(int index) const { return (index >= 0 && index <= _StackTop) ? _PageStack[index] : nullptr; }
+    int GetPoolSize() const { return _PagePoolSize; }
+    PageBase* GetPoolPage(int index) const { return (index >= 0 && index < _PagePoolSize) ? _PagePool[index] : nullptr; }
+
 private:
     // Page pool management
     PageBase* FindPageInPool(const char* name);
+    static uint32_t HashName(const char* name);
+    void IndexInsert(int poolIndex);
+    void IndexRebuild();
     
     // Page stack management
     PageBase* GetStackTop();
@@ -58,6 +91,27 @@ private:
     bool SwitchTo(PageBase* page, bool isEnterAct);
     static void onSwitchAnimFinish(lv_anim_t* a);
     void SwitchAnimCreate(PageBase* page);
+    void SwitchAnimFinish();
+    lv_obj_t* GetAnimTarget(PageBase* page);
+
+    // Memory pressure: unload hidden pages, oldest first
+    void ReclaimMemory();
+    PageBase* FindUnloadCandidate();
+
+    // Background loading of queued pages
+    static void onPreloadTimer(lv_timer_t* timer);
+    void PreloadStep();
+
+#if DISP_PAGE_SNAPSHOT
+    // Show the page's picture in place of its (hidden) root
+    bool SnapshotShow(PageBase* page);
+    // Bring the live root back and hide the picture
+    void SnapshotSwap();
+    static void onSnapshotTimer(lv_timer_t* timer);
+    // Picture the page that is about to disappear (at most once per
+    // DISP_SNAPSHOT_MIN_INTERVAL_MS per page)
+    void SnapshotCapture(PageBase* page);
+#endif
     
     // State management
     PageBase::State_t StateLoadExecute(PageBase* page);
@@ -73,6 +127,11 @@ private:
     PageBase* _PagePool[MAX_PAGES];
     int _PagePoolSize;
 
+    // Open-addressed index from name hash to pool slot, so lookups by name
+    // cost one hash and (almost always) a single string compare
+    int8_t _NameIndex[PAGE_NAME_SLOTS];
+    uint32_t _NameHash[MAX_PAGES];
+
     // Page stack (using simple array instead of std::stack)
     PageBase* _PageStack[MAX_STACK_SIZE];
     int _StackTop;
@@ -87,5 +146,50 @@ private:
         bool IsBusy;
         bool IsEntering;
         PageBase::AnimAttr_t Global;
+        uint32_t StartMs;
+        uint32_t StartFrames;
     } _AnimState;
+
+    // Frame rate per transition type, measured over each transition
+    struct AnimStats {
+        uint16_t Runs;
+        uint16_t MinFps;
+        uint32_t Frames;
+        uint32_t Ms;
+    } _AnimStats[_LOAD_ANIM_LAST];
+
+    // LRU unloading of hidden pages under memory pressure
+    uint32_t _ShowClock;
+    uint32_t _UnloadFree;
+    struct {
+        uint32_t Triggers;          // Checks that found the heap below _UnloadFree
+        uint32_t Unloads;           // Pages unloaded
+        uint32_t Rebuilds;          // Unloaded pages built again when shown
+        uint32_t Starved;           // Triggers with nothing left to unload
+        uint32_t LowestFree;        // Least free heap seen by a check
+    } _UnloadStats;
+
+    // Pages to build while the UI is idle
+    PageBase* _PreloadQueue[PAGE_PRELOAD_SLOTS];
+    int _PreloadCount;
+    lv_timer_t* _PreloadTimer;
+    struct {
+        uint32_t Built;             // Pages built ahead of time
+        uint32_t Used;              // Switches that found the page built ahead
+        uint32_t NoRoom;            // Skipped, would leave less than _UnloadFree
+        uint32_t Dropped;           // Built, then unloaded again for lack of room
+        uint32_t TotalUs;
+        uint32_t MaxUs;             // Longest slice
+    } _PreloadStats;
+
+#if DISP_PAGE_SNAPSHOT
+    // Picture of the entering page, shown for the transition (or the first
+    // frame) so its widget tree is not rendered until it stands still
+    SnapshotCache _Snapshots;
+    lv_obj_t* _SnapshotImg;
+    PageBase* _SnapshotPage;        // Page _SnapshotImg stands in for
+    lv_timer_t* _SnapshotTimer;     // Swaps the live root in after one frame
+    uint32_t _SnapshotFrames;
+    uint32_t _SnapshotTick;
+#endif
 };
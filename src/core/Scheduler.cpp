@@ -0,0 +1,173 @@
+#include "Scheduler.h"
+#include "../utils/LoopWatchdog.h"
+
+Scheduler& Scheduler::getInstance() {
+    static Scheduler instance;
+    return instance;
+}
+
+Scheduler::Scheduler() {
+    for (int i = 0; i < SCHED_MAX_JOBS; i++) {
+        jobs[i].heapIndex = -1;
+    }
+}
+
+int Scheduler::every(uint32_t periodMs, SchedulerCallback cb, void* userData, const char* name) {
+    if (periodMs == 0) periodMs = 1;
+    return add(periodMs, periodMs, cb, userData, name);
+}
+
+int Scheduler::after(uint32_t delayMs, SchedulerCallback cb, void* userData, const char* name) {
+    return add(delayMs, 0, cb, userData, name);
+}
+
+int Scheduler::add(uint32_t delayMs, uint32_t periodMs, SchedulerCallback cb, void* userData, const char* name) {
+    if (!cb) return SCHED_INVALID_JOB;
+
+    for (int id = 0; id < SCHED_MAX_JOBS; id++) {
+        Job& job = jobs[id];
+        if (job.heapIndex >= 0) continue;
+
+        job.cb = cb;
+        job.userData = userData;
+        job.name = name ? name : "?";
+        job.deadline = millis() + delayMs;
+        job.period = periodMs;
+        job.runs = 0;
+        job.maxRunUs = 0;
+
+        job.heapIndex = heapSize;
+        heap[heapSize++] = id;
+        siftUp(job.heapIndex);
+        return id;
+    }
+
+    Serial.printf("Scheduler: No free slot for job %s\n", name ? name : "?");
+    return SCHED_INVALID_JOB;
+}
+
+bool Scheduler::cancel(int id) {
+    if (!isPending(id)) return false;
+    removeAt(jobs[id].heapIndex);
+    return true;
+}
+
+void Scheduler::cancel(int* id) {
+    if (!id || *id == SCHED_INVALID_JOB) return;
+    cancel(*id);
+    *id = SCHED_INVALID_JOB;
+}
+
+bool Scheduler::isPending(int id) const {
+    return id >= 0 && id < SCHED_MAX_JOBS && jobs[id].heapIndex >= 0;
+}
+
+void Scheduler::run() {
+    uint32_t now = millis();
+
+    // Bounded so a periodic job that keeps falling behind can't starve the loop
+    for (int budget = SCHED_MAX_JOBS; heapSize > 0 && budget > 0; budget--) {
+        int id = heap[0];
+        Job& job = jobs[id];
+        if ((int32_t)(now - job.deadline) < 0) break;
+
+        uint32_t lateness = now - job.deadline;
+        if (lateness > 1) lateRuns++;
+        if (lateness > maxLatenessMs) maxLatenessMs = lateness;
+
+        // Re-arm (or drop) before the call so the callback may cancel or re-add itself
+        if (job.period) {
+            job.deadline += job.period;
+            // Far behind (e.g. a blocking tone): skip the missed periods
+            if ((int32_t)(now - job.deadline) > (int32_t)(job.period * 4)) {
+                job.deadline = now + job.period;
+            }
+            siftDown(0);
+        } else {
+            removeAt(0);
+        }
+
+        LoopWdt.mark(LOOP_STAGE_SCHED, job.name);
+        uint32_t startUs = micros();
+        job.cb(job.userData);
+        uint32_t runUs = micros() - startUs;
+
+        // The slot may already hold another job if this one was removed
+        if (job.period && job.heapIndex >= 0) {
+            job.runs++;
+            if (runUs > job.maxRunUs) job.maxRunUs = runUs;
+        }
+        totalRuns++;
+        now = millis();
+    }
+}
+
+uint32_t Scheduler::msUntilNext() const {
+    if (heapSize == 0) return UINT32_MAX;
+
+    int32_t remaining = (int32_t)(jobs[heap[0]].deadline - millis());
+    return remaining > 0 ? (uint32_t)remaining : 0;
+}
+
+void Scheduler::printStats() {
+    Serial.printf("Scheduler: %u jobs pending, %lu runs, %lu late (max %lu ms)\n",
+                  (unsigned)heapSize, (unsigned long)totalRuns,
+                  (unsigned long)lateRuns, (unsigned long)maxLatenessMs);
+    for (int i = 0; i < heapSize; i++) {
+        const Job& job = jobs[heap[i]];
+        Serial.printf("  %-10s %s %lu ms, %lu runs, max %lu us\n",
+                      job.name, job.period ? "every" : "in",
+                      (unsigned long)(job.period ? job.period : job.deadline - millis()),
+                      (unsigned long)job.runs, (unsigned long)job.maxRunUs);
+    }
+}
+
+void Scheduler::removeAt(int pos) {
+    int id = heap[pos];
+    jobs[id].heapIndex = -1;
+
+    heapSize--;
+    if (pos == heapSize) return;
+
+    int moved = heap[heapSize];
+    heap[pos] = moved;
+    jobs[moved].heapIndex = pos;
+    siftUp(pos);
+    siftDown(jobs[moved].heapIndex);
+}
+
+bool Scheduler::earlier(int a, int b) const {
+    return (int32_t)(jobs[heap[a]].deadline - jobs[heap[b]].deadline) < 0;
+}
+
+void Scheduler::swapNodes(int a, int b) {
+    int8_t tmp = heap[a];
+    heap[a] = heap[b];
+    heap[b] = tmp;
+    jobs[heap[a]].heapIndex = a;
+    jobs[heap[b]].heapIndex = b;
+}
+
+void Scheduler::siftUp(int pos) {
+    while (pos > 0) {
+        int parent = (pos - 1) / 2;
+        if (!earlier(pos, parent)) break;
+        swapNodes(pos, parent);
+        pos = parent;
+    }
+}
+
+void Scheduler::siftDown(int pos) {
+    while (true) {
+        int left = pos * 2 + 1;
+        int right = left + 1;
+        int smallest = pos;
+
+        if (left < heapSize && earlier(left, smallest)) smallest = left;
+        if (right < heapSize && earlier(right, smallest)) smallest = right;
+        if (smallest == pos) break;
+
+        swapNodes(pos, smallest);
+        pos = smallest;
+    }
+}
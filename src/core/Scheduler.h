@@ -0,0 +1,75 @@
+#pragma once
+
+#include <Arduino.h>
+
+#define SCHED_MAX_JOBS 16
+#define SCHED_INVALID_JOB -1
+
+typedef void (*SchedulerCallback)(void* userData);
+
+// Runs one-shot and periodic jobs from the main loop. Pending jobs are kept
+// in a min-heap of deadlines, so the loop can ask how long it may sleep.
+// Periodic jobs are scheduled from their previous deadline, not from the
+// time they actually ran, so they don't drift.
+class Scheduler {
+public:
+    static Scheduler& getInstance();
+
+    // Add a job; returns its id or SCHED_INVALID_JOB when the table is full
+    int every(uint32_t periodMs, SchedulerCallback cb, void* userData, const char* name);
+    int after(uint32_t delayMs, SchedulerCallback cb, void* userData, const char* name);
+
+    // Remove a pending job (safe to call from inside its own callback)
+    bool cancel(int id);
+    // Cancel *id if it is set and mark it unset
+    void cancel(int* id);
+    bool isPending(int id) const;
+
+    // Run all jobs that are due
+    void run();
+
+    // Milliseconds until the next deadline (UINT32_MAX if nothing is pending)
+    uint32_t msUntilNext() const;
+
+    // Status
+    uint32_t getPendingCount() const { return heapSize; }
+    void printStats();
+
+private:
+    Scheduler();
+    ~Scheduler() = default;
+    Scheduler(const Scheduler&) = delete;
+    Scheduler& operator=(const Scheduler&) = delete;
+
+    struct Job {
+        SchedulerCallback cb;
+        void* userData;
+        const char* name;
+        uint32_t deadline;
+        uint32_t period;     // 0 = one-shot
+        int16_t heapIndex;   // -1 = free slot
+        uint32_t runs;
+        uint32_t maxRunUs;
+    };
+
+    int add(uint32_t delayMs, uint32_t periodMs, SchedulerCallback cb, void* userData, const char* name);
+    void removeAt(int pos);
+
+    // Heap helpers (heap[] holds job slots ordered by deadline)
+    bool earlier(int a, int b) const;
+    void swapNodes(int a, int b);
+    void siftUp(int pos);
+    void siftDown(int pos);
+
+    Job jobs[SCHED_MAX_JOBS];
+    int8_t heap[SCHED_MAX_JOBS];
+    uint8_t heapSize = 0;
+
+    // Statistics
+    uint32_t totalRuns = 0;
+    uint32_t lateRuns = 0;       // Jobs that ran more than a tick past their deadline
+    uint32_t maxLatenessMs = 0;
+};
+
+// Global instance access
+#define Sched Scheduler::getInstance()
@@ -0,0 +1,184 @@
+#include "TaskManager.h"
+#include "../utils/LoopWatchdog.h"
+#include "../utils/SleepManager.h"
+
+static const char* const taskNames[APP_TASK_COUNT] = { "net", "audio" };
+
+TaskManager& TaskManager::getInstance() {
+    static TaskManager instance;
+    return instance;
+}
+
+void TaskManager::begin() {
+    if (started) return;
+
+#if APP_USE_RTOS
+    static const uint16_t stacks[APP_TASK_COUNT] = { APP_NET_STACK, APP_AUDIO_STACK };
+    static const UBaseType_t priorities[APP_TASK_COUNT] = { APP_NET_PRIORITY, APP_AUDIO_PRIORITY };
+
+    for (uint8_t t = 0; t < APP_TASK_COUNT; t++) {
+        jobQueues[t] = xQueueCreate(TASK_QUEUE_DEPTH, sizeof(Job));
+        if (!jobQueues[t] ||
+            xTaskCreate(workerMain, taskNames[t], stacks[t], jobQueues[t], priorities[t], &workers[t]) != pdPASS) {
+            Serial.printf("TaskManager: Cannot create %s task\n", taskNames[t]);
+            return;
+        }
+    }
+    Serial.println("TaskManager: Worker tasks created");
+#endif
+    started = true;
+}
+
+void TaskManager::run(void (*uiLoop)()) {
+#if APP_USE_RTOS
+    if (!started) return;
+
+    // Some libraries (e.g. the WiFi RPC layer) start FreeRTOS themselves and
+    // the Arduino loop already runs as a task; otherwise start it here
+    if (xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED) {
+        xTaskCreate(uiMain, "ui", APP_UI_STACK, (void*)uiLoop, APP_UI_PRIORITY, &uiTask);
+        Serial.println("TaskManager: Starting scheduler");
+        vTaskStartScheduler();
+        Serial.println("TaskManager: Scheduler returned (out of heap?)");
+    }
+#else
+    (void)uiLoop;
+#endif
+}
+
+bool TaskManager::submit(AppTaskId task, TaskWorkFn work, TaskDoneFn done, void* ctx, const char* name) {
+    if (task >= APP_TASK_COUNT || !work || !started) return false;
+
+    Job job = { work, done, ctx, name ? name : "?", (uint8_t)task, false };
+
+#if APP_USE_RTOS
+    if (xQueueSend(jobQueues[task], &job, 0) != pdPASS) {
+        rejected[task]++;
+        Serial.printf("TaskManager: %s queue full, dropped %s\n", taskNames[task], job.name);
+        return false;
+    }
+    busy[task]++;
+#else
+    busy[task]++;
+    runJob(job);
+    if (!pushDone(job)) {
+        // Mailbox full: deliver right away rather than lose it
+        busy[task]--;
+        if (job.done) job.done(job.ctx, job.ok);
+    }
+#endif
+    submitted[task]++;
+    return true;
+}
+
+void TaskManager::runJob(Job& job) {
+    uint32_t startMs = millis();
+    job.ok = job.work(job.ctx);
+    uint32_t runMs = millis() - startMs;
+    if (runMs > maxRunMs[job.task]) maxRunMs[job.task] = runMs;
+}
+
+uint8_t TaskManager::poll(uint8_t maxJobs) {
+    uint8_t delivered = 0;
+    Job job;
+
+    // The rest waits for the next pass, so one pass stays short
+    while (delivered < maxJobs && doneBox.take(job)) {
+        if (busy[job.task] > 0) busy[job.task]--;
+        LoopWdt.mark(LOOP_STAGE_TASKS, job.name);
+        if (job.done) job.done(job.ctx, job.ok);
+        delivered++;
+    }
+    return delivered;
+}
+
+bool TaskManager::pushDone(const Job& job) {
+#if APP_USE_RTOS
+    // A done callback must not get lost; the UI loop never waits on a
+    // worker, so waiting here for it to make room can't deadlock
+    while (!doneBox.post(job)) {
+        sleep(1);
+    }
+    SleepMgr.wake();
+    return true;
+#else
+    return doneBox.post(job);
+#endif
+}
+
+#if APP_USE_RTOS
+void TaskManager::workerMain(void* param) {
+    QueueHandle_t queue = (QueueHandle_t)param;
+    TaskManager& self = getInstance();
+    Job job;
+
+    for (;;) {
+        if (xQueueReceive(queue, &job, portMAX_DELAY) != pdTRUE) continue;
+        self.runJob(job);
+        self.pushDone(job);
+    }
+}
+
+void TaskManager::uiMain(void* param) {
+    void (*uiLoop)() = (void (*)())param;
+    for (;;) {
+        uiLoop();
+    }
+}
+#endif
+
+void TaskManager::sleep(uint32_t ms) {
+#if APP_USE_RTOS
+    if (ms == 0) {
+        taskYIELD();
+    } else {
+        vTaskDelay(pdMS_TO_TICKS(ms));
+    }
+#else
+    if (ms > 0) delay(ms);
+#endif
+}
+
+bool TaskManager::playTones(const TonePattern* pattern) {
+    if (!pattern || !pattern->notes) return false;
+    return submit(TASK_AUDIO, tonesWork, nullptr, (void*)pattern, "tones");
+}
+
+void TaskManager::stopTones() {
+    toneEpoch = toneEpoch + 1;
+    noTone(APP_SPEAKER_PIN);
+}
+
+bool TaskManager::tonesWork(void* ctx) {
+    const TonePattern* pattern = (const TonePattern*)ctx;
+    TaskManager& self = getInstance();
+    uint32_t epoch = self.toneEpoch;
+
+    pinMode(APP_SPEAKER_PIN, OUTPUT);
+    for (uint8_t r = 0; r < pattern->repeat; r++) {
+        for (uint8_t i = 0; i < pattern->count; i++) {
+            if (self.toneEpoch != epoch) return false; // Stopped
+            const ToneNote& note = pattern->notes[i];
+            if (note.freq) tone(APP_SPEAKER_PIN, note.freq, note.toneMs);
+            sleep(note.stepMs);
+        }
+    }
+    noTone(APP_SPEAKER_PIN);
+    return true;
+}
+
+void TaskManager::printStats() {
+    Serial.printf("TaskManager: %s\n", APP_USE_RTOS ? "FreeRTOS workers" : "inline (APP_USE_RTOS=0)");
+    for (uint8_t t = 0; t < APP_TASK_COUNT; t++) {
+        Serial.printf("  %-6s %lu jobs, %lu rejected, %u busy, longest %lu ms",
+                      taskNames[t], (unsigned long)submitted[t], (unsigned long)rejected[t],
+                      (unsigned)busy[t], (unsigned long)maxRunMs[t]);
+#if APP_USE_RTOS
+        if (workers[t]) {
+            Serial.printf(", stack free %u words", (unsigned)uxTaskGetStackHighWaterMark(workers[t]));
+        }
+#endif
+        Serial.println();
+    }
+    doneBox.printStats("done");
+}
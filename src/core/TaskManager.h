@@ -0,0 +1,115 @@
+#pragma once
+
+#include <Arduino.h>
+#include "../config/app_config.h"
+#include "../utils/Mailbox.h"
+
+#if APP_USE_RTOS
+#include <Seeed_Arduino_FreeRTOS.h>
+#endif
+
+#define TASK_QUEUE_DEPTH 4      // Jobs waiting per worker
+#define TASK_DONE_DEPTH 8       // Finished jobs waiting for the UI loop (power of two)
+#define TASK_POLL_BUDGET 4      // Done callbacks run per UI loop pass
+
+enum AppTaskId : uint8_t {
+    TASK_NET = 0,       // WiFi, HTTP, JSON parsing
+    TASK_AUDIO,         // Speaker tone sequences
+    APP_TASK_COUNT
+};
+
+// Runs on the worker; must not call lv_* functions
+typedef bool (*TaskWorkFn)(void* ctx);
+// Runs on the UI loop once the work is done
+typedef void (*TaskDoneFn)(void* ctx, bool ok);
+
+// One step of a tone sequence (freq 0 = rest)
+struct ToneNote {
+    uint16_t freq;
+    uint16_t toneMs;
+    uint16_t stepMs;    // Time until the next note
+};
+
+// A tone sequence for the audio task; must stay valid while it plays
+struct TonePattern {
+    const ToneNote* notes;
+    uint8_t count;
+    uint8_t repeat;
+};
+
+// Moves blocking work off the UI loop. With APP_USE_RTOS every AppTaskId
+// is a FreeRTOS task fed by a job queue, and finished jobs come back through
+// a lock-free mailbox the UI loop drains a few at a time with poll(), so a
+// burst of results can't stall a frame. Without it the work runs inline
+// as before, but done callbacks are still deferred to poll(), so callers
+// see the same order in both builds.
+class TaskManager {
+public:
+    static TaskManager& getInstance();
+
+    // Create the workers; jobs may be submitted from then on
+    void begin();
+    // With APP_USE_RTOS start the scheduler if nothing has yet and run
+    // uiLoop forever in the UI task (no return); otherwise return at once
+    void run(void (*uiLoop)());
+
+    // Queue work for a worker; false if its queue is full
+    bool submit(AppTaskId task, TaskWorkFn work, TaskDoneFn done, void* ctx, const char* name);
+
+    // Call the done callbacks of up to maxJobs finished jobs (UI loop only)
+    uint8_t poll(uint8_t maxJobs = TASK_POLL_BUDGET);
+
+    // Jobs queued or running on a worker
+    uint8_t getBusyCount(AppTaskId task) const { return task < APP_TASK_COUNT ? busy[task] : 0; }
+
+    // Speaker patterns on the audio task
+    bool playTones(const TonePattern* pattern);
+    void stopTones();
+
+    // Sleep the calling task (lets the workers run)
+    static void sleep(uint32_t ms);
+
+    // Status
+    void printStats();
+
+private:
+    TaskManager() = default;
+    ~TaskManager() = default;
+    TaskManager(const TaskManager&) = delete;
+    TaskManager& operator=(const TaskManager&) = delete;
+
+    struct Job {
+        TaskWorkFn work;
+        TaskDoneFn done;
+        void* ctx;
+        const char* name;
+        uint8_t task;
+        bool ok;
+    };
+
+    void runJob(Job& job);
+    bool pushDone(const Job& job);
+    static bool tonesWork(void* ctx);
+
+#if APP_USE_RTOS
+    static void workerMain(void* param);
+    static void uiMain(void* param);
+
+    QueueHandle_t jobQueues[APP_TASK_COUNT] = {};
+    TaskHandle_t workers[APP_TASK_COUNT] = {};
+    TaskHandle_t uiTask = nullptr;
+#endif
+    Mailbox<Job, TASK_DONE_DEPTH> doneBox;
+    bool started = false;
+
+    uint8_t busy[APP_TASK_COUNT] = {};   // Only touched by the UI loop
+    volatile uint32_t toneEpoch = 0;    // Bumped by stopTones()
+
+    // Statistics
+    uint32_t submitted[APP_TASK_COUNT] = {};
+    uint32_t rejected[APP_TASK_COUNT] = {};
+    volatile uint32_t maxRunMs[APP_TASK_COUNT] = {};
+};
+
+// Global instance access
+#define Tasks TaskManager::getInstance()
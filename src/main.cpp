@@ -1,153 +1,331 @@
 #include <Arduino.h>
-#include <TFT_eSPI.h>
 #include "lvgl.h"
 #include "theme/style_manager.h"
 #include "core/AppManager.h"
+#include "core/Scheduler.h"
+#include "core/TaskManager.h"
+#include "utils/DisplayManager.h"
+#include "utils/FrameGovernor.h"
+#include "utils/FrameProfiler.h"
+#include "utils/BoundLabel.h"
+#include "utils/InputManager.h"
+#include "utils/InputTrace.h"
+#include "utils/GestureEngine.h"
+#include "utils/LatencyTracker.h"
+#include "utils/LoopWatchdog.h"
+#include "utils/SerialConsole.h"
+#include "utils/SleepManager.h"
+#include "utils/WiFiManager.h"
+#if DISP_BENCHMARK
+#include "utils/DisplayBenchmark.h"
+#endif
 
 // Global app manager
 AppManager* appManager = nullptr;
 
-static lv_disp_draw_buf_t draw_buf;
-static lv_color_t buf1[320 * 10];
-static lv_disp_drv_t disp_drv;
-static TFT_eSPI tft = TFT_eSPI();
-
-// Joystick pins (Wio Terminal)
-#define JOYSTICK_UP    WIO_5S_UP
-#define JOYSTICK_DOWN  WIO_5S_DOWN
-#define JOYSTICK_LEFT  WIO_5S_LEFT
-#define JOYSTICK_RIGHT WIO_5S_RIGHT
-#define JOYSTICK_PRESS WIO_5S_PRESS
-
-// Physical button pins
-#define KEY_A_PIN      WIO_KEY_A
-#define KEY_B_PIN      WIO_KEY_B
-#define KEY_C_PIN      WIO_KEY_C
-
-// Input state tracking
-static bool lastJoystickState[5] = {false, false, false, false, false};
-static bool lastKeyState[3] = {false, false, false};
-static unsigned long lastJoystickTime = 0;
-static unsigned long lastKeyTime = 0;
-static const unsigned long INPUT_DEBOUNCE = 200; // ms
-
-void my_disp_flush(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color_p) {
-    uint32_t w = (area->x2 - area->x1 + 1);
-    uint32_t h = (area->y2 - area->y1 + 1);
-
-    tft.startWrite();
-    tft.setAddrWindow(area->x1, area->y1, w, h);
-    tft.pushColors((uint16_t*)&color_p->full, w * h, true);
-    tft.endWrite();
-
-    lv_disp_flush_ready(disp);
-}
-
-void handleJoystickInput() {
-    unsigned long currentTime = millis();
-    if (currentTime - lastJoystickTime < INPUT_DEBOUNCE) {
-        return; // Debounce protection
+// Plain key presses the visible page didn't take as a gesture
+void handleKeyPress(InputKey key) {
+    switch (key) {
+        case INPUT_UP:
+        case INPUT_DOWN:
+            // Up/Down directions can be used for in-page navigation, not handled for now
+            break;
+        case INPUT_LEFT:
+            if (appManager) appManager->handleInput(LV_DIR_LEFT);
+            break;
+        case INPUT_RIGHT:
+            if (appManager) appManager->handleInput(LV_DIR_RIGHT);
+            break;
+        case INPUT_PRESS:
+            if (appManager) appManager->handleInput(LV_DIR_NONE); // Press means selection
+            break;
+        case INPUT_KEY_A:
+            if (appManager) appManager->handleKeyA(true);
+            break;
+        case INPUT_KEY_B:
+            if (appManager) appManager->handleKeyB(true);
+            break;
+        case INPUT_KEY_C:
+            if (appManager) appManager->handleKeyC(true);
+            break;
+        default:
+            break;
     }
+}
 
-    // Wio Terminal joystick is active LOW (LOW when pressed)
-    bool currentState[5] = {
-        !digitalRead(JOYSTICK_UP),    // Invert because it's active LOW
-        !digitalRead(JOYSTICK_DOWN),
-        !digitalRead(JOYSTICK_LEFT),
-        !digitalRead(JOYSTICK_RIGHT),
-        !digitalRead(JOYSTICK_PRESS)
-    };
-
-    // Detect button press events (from false to true)
-    if (!lastJoystickState[0] && currentState[0]) { // UP
-        Serial.println("Joystick UP pressed");
-        // Up/Down directions can be used for in-page navigation, not handled for now
-        lastJoystickTime = currentTime;
-    }
-    else if (!lastJoystickState[1] && currentState[1]) { // DOWN
-        Serial.println("Joystick DOWN pressed");
-        // Up/Down directions can be used for in-page navigation, not handled for now
-        lastJoystickTime = currentTime;
+// Deliver gestures to the app
+void handleGesture(const Gesture& gesture) {
+    Serial.printf("Input %s %s (#%u)\n", InputManager::getKeyName(gesture.key),
+                  GestureEngine::getTypeName(gesture.type), (unsigned)gesture.seq);
+
+#if DISP_LATENCY_TRACKER
+    InputEvent source = { gesture.key, true, gesture.seq, gesture.timeMs };
+    LatencyTrk.beginDispatch(source);
+#endif
+    LoopWdt.mark(LOOP_STAGE_INPUT, InputManager::getKeyName(gesture.key));
+    bool used = appManager && appManager->handleGesture(gesture);
+    if (!used && gesture.type == GESTURE_PRESS) {
+        handleKeyPress(gesture.key);
     }
-    else if (!lastJoystickState[2] && currentState[2]) { // LEFT
-        Serial.println("Joystick LEFT pressed");
-        if (appManager) appManager->handleInput(LV_DIR_LEFT);
-        lastJoystickTime = currentTime;
+#if DISP_LATENCY_TRACKER
+    LatencyTrk.endDispatch();
+#endif
+    FrameGov.kick();
+}
+
+// Debounced key changes from the interrupts
+void handleInputEvent(const InputEvent& event) {
+    // A real key takes over from a replay
+    if (InputTrc.isReplaying()) InputTrc.stopReplay();
+    InputTrc.record(event);
+    Gestures.onInput(event);
+}
+
+// Key changes played back from a trace
+void handleReplayEvent(const InputEvent& event) {
+    Gestures.onInput(event);
+}
+
+#if DISP_STATS_LOG_MS > 0
+void logStats(void* userData) {
+    (void)userData;
+    DisplayMgr.printRefreshStats();
+    FrameGov.printStats();
+    BoundLabel::printStats();
+    InputMgr.printStats();
+    Gestures.printStats();
+    InputTrc.printStats();
+#if DISP_LATENCY_TRACKER
+    LatencyTrk.printReport();
+#endif
+    Sched.printStats();
+    LoopWdt.printStats();
+    SleepMgr.printStats();
+    Tasks.printStats();
+    WiFiMgr.printEventStats();
+    if (appManager) {
+        appManager->getPageManager()->PrintAnimStats();
+        appManager->getPageManager()->PrintSnapshotStats();
+        appManager->getPageManager()->PrintUnloadStats();
+        appManager->getPageManager()->PrintPreloadStats();
     }
-    else if (!lastJoystickState[3] && currentState[3]) { // RIGHT
-        Serial.println("Joystick RIGHT pressed");
-        if (appManager) appManager->handleInput(LV_DIR_RIGHT);
-        lastJoystickTime = currentTime;
+#if DISP_PROFILER
+    FrameProf.printSummary();
+#endif
+}
+#endif
+
+#if APP_TRACE_REPLAY
+void onTraceReplayDone() {
+#if DISP_STATS_LOG_MS > 0
+    logStats(nullptr);
+#endif
+}
+
+// Stats of the replayed session only
+void startTraceReplay() {
+    if (!InputTrc.load(APP_TRACE_PATH)) return;
+#if DISP_LATENCY_TRACKER
+    LatencyTrk.reset();
+#endif
+    InputTrc.startReplay(APP_TRACE_REPLAY == 2 ? TRACE_REPLAY_FAST : TRACE_REPLAY_REALTIME,
+                         handleReplayEvent, onTraceReplayDone);
+}
+#endif
+
+#if APP_TRACE_RECORD
+// Keep the trace file current, so the board can simply be switched off
+void saveTrace(void* userData) {
+    static uint16_t savedCount = 0;
+    (void)userData;
+    if (InputTrc.getCount() == savedCount) return;
+    if (InputTrc.save(APP_TRACE_PATH)) savedCount = InputTrc.getCount();
+}
+#endif
+
+#if APP_CONSOLE
+static const char* const pageStateNames[] = {
+    "idle", "load", "will appear", "did appear", "active", "will disappear", "did disappear", "unload"
+};
+
+static const char* getPageStateName(const PageBase* page) {
+    uint8_t state = page->priv.State;
+    return state < PageBase::_PAGE_STATE_LAST ? pageStateNames[state] : "?";
+}
+
+void cmdPage(int argc, char** argv) {
+    (void)argc; (void)argv;
+    PageManager* pm = appManager->getPageManager();
+    PageBase* current = pm->GetCurrentPage();
+
+    Serial.printf("Page: %s (%s)\n", current ? current->_Name : "-",
+                  current ? getPageStateName(current) : "-");
+    Serial.print("Stack:");
+    for (int i = 0; i < pm->GetStackDepth(); i++) {
+        Serial.printf(" %s", pm->GetStackPage(i)->_Name);
     }
-    else if (!lastJoystickState[4] && currentState[4]) { // PRESS
-        Serial.println("Joystick PRESS pressed");
-        if (appManager) appManager->handleInput(LV_DIR_NONE); // Press means selection
-        lastJoystickTime = currentTime;
+    Serial.println(pm->GetStackDepth() ? "" : " (empty)");
+    Serial.print("Pages:");
+    for (int i = 0; i < pm->GetPoolSize(); i++) {
+        PageBase* page = pm->GetPoolPage(i);
+        Serial.printf(" %s%s", page->_Name, page->_root ? "*" : "");
     }
+    Serial.println(" (* = view loaded)");
+    pm->PrintPreloadStats();
+}
 
-    // Update state
-    for (int i = 0; i < 5; i++) {
-        lastJoystickState[i] = currentState[i];
+void cmdGo(int argc, char** argv) {
+    if (argc < 2 || !appManager->showPage(argv[1])) {
+        Serial.println("Usage: go <page name> (see page)");
     }
 }
 
-void handleKeyInput() {
-    unsigned long currentTime = millis();
-    if (currentTime - lastKeyTime < INPUT_DEBOUNCE) {
-        return; // Debounce protection
+void cmdMem(int argc, char** argv) {
+    (void)argc; (void)argv;
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    Serial.printf("LVGL heap: %lu of %lu bytes used (%u%%), max %lu, biggest free %lu, frag %u%%\n",
+                  (unsigned long)(mon.total_size - mon.free_size), (unsigned long)mon.total_size,
+                  (unsigned)mon.used_pct, (unsigned long)mon.max_used,
+                  (unsigned long)mon.free_biggest_size, (unsigned)mon.frag_pct);
+    if (appManager) {
+        appManager->getPageManager()->PrintSnapshotStats();
+        appManager->getPageManager()->PrintUnloadStats();
     }
+}
 
-    // Wio Terminal keys are active LOW (LOW when pressed)
-    bool currentKeyState[3] = {
-        !digitalRead(KEY_A_PIN),
-        !digitalRead(KEY_B_PIN),
-        !digitalRead(KEY_C_PIN)
-    };
-
-    // Detect key press events (from false to true)
-    if (!lastKeyState[0] && currentKeyState[0]) { // Key A
-        Serial.println("Key A pressed");
-        if (appManager) appManager->handleKeyA(true);
-        lastKeyTime = currentTime;
-    }
-    else if (!lastKeyState[1] && currentKeyState[1]) { // Key B
-        Serial.println("Key B pressed");
-        if (appManager) appManager->handleKeyB(true);
-        lastKeyTime = currentTime;
-    }
-    else if (!lastKeyState[2] && currentKeyState[2]) { // Key C
-        Serial.println("Key C pressed");
-        if (appManager) appManager->handleKeyC(true);
-        lastKeyTime = currentTime;
-    }
+void cmdLoop(int argc, char** argv) {
+    (void)argc; (void)argv;
+    FrameGov.printStats();
+    LoopWdt.printStats();
+    SleepMgr.printStats();
+    Sched.printStats();
+    Tasks.printStats();
+}
 
-    // Update state
-    for (int i = 0; i < 3; i++) {
-        lastKeyState[i] = currentKeyState[i];
+// WiFi calls are RPCs to the radio; ask from the network task so they never
+// interleave with a connect running there
+bool wifiStatusWork(void* ctx) {
+    (void)ctx;
+    Serial.printf("WiFi: %s, %s", WiFiMgr.isInitialized() ? "initialized" : "not initialized",
+                  WiFiMgr.getStatusString().c_str());
+    if (WiFiMgr.isConnected()) {
+        Serial.printf(", SSID %s, IP %s, RSSI %d dBm", WiFiMgr.getSSID().c_str(),
+                      WiFiMgr.getLocalIP().c_str(), WiFiMgr.getSignalStrength());
     }
+    Serial.println();
+    return true;
 }
 
-void loop() {
-    lv_timer_handler();
-    handleJoystickInput();
-    handleKeyInput();
-
-    // Update timers and alarms periodically
-    static unsigned long lastUpdate = 0;
-    unsigned long currentTime = millis();
-    if (currentTime - lastUpdate > 1000) { // Update every 1 second
-        if (appManager) appManager->update();
-        lastUpdate = currentTime;
+void cmdWiFi(int argc, char** argv) {
+    (void)argc; (void)argv;
+    WiFiMgr.printEventStats();
+    if (!Tasks.submit(TASK_NET, wifiStatusWork, nullptr, nullptr, "wifi?")) {
+        Serial.println("WiFi: Network task busy, try again");
     }
+}
+
+void cmdWeather(int argc, char** argv) {
+    (void)argc; (void)argv;
+    Serial.println(appManager->refreshWeather() ? "Weather: Refresh requested" : "Weather: No weather page");
+}
 
-    // Force screen refresh periodically
-    static unsigned long lastRefresh = 0;
-    if (currentTime - lastRefresh > 100) { // Refresh every 100ms
-        lv_refr_now(NULL);
-        lastRefresh = currentTime;
+#if DISP_STATS_LOG_MS > 0
+void cmdStats(int argc, char** argv) {
+    (void)argc; (void)argv;
+    logStats(nullptr);
+}
+#endif
+
+void cmdTrace(int argc, char** argv) {
+    const char* op = argc > 1 ? argv[1] : "";
+    const char* path = argc > 2 ? argv[2] : APP_TRACE_PATH;
+
+    if (strcmp(op, "rec") == 0) {
+        InputTrc.startRecording();
+    } else if (strcmp(op, "stop") == 0) {
+        InputTrc.stopRecording();
+        InputTrc.stopReplay();
+    } else if (strcmp(op, "save") == 0) {
+        InputTrc.save(path);
+    } else if (strcmp(op, "load") == 0) {
+        InputTrc.load(path);
+    } else if (strcmp(op, "play") == 0 || strcmp(op, "fast") == 0) {
+#if DISP_LATENCY_TRACKER
+        LatencyTrk.reset();
+#endif
+        bool fast = op[0] == 'f';
+        if (!InputTrc.startReplay(fast ? TRACE_REPLAY_FAST : TRACE_REPLAY_REALTIME,
+                                  handleReplayEvent, nullptr)) {
+            Serial.println("InputTrace: Nothing to replay");
+        }
+    } else if (strcmp(op, "dump") == 0) {
+        InputTrc.dump();
+    } else {
+        InputTrc.printStats();
+        Serial.println("Usage: trace rec|stop|save [path]|load [path]|play|fast|dump");
     }
+}
+
+void setupConsole() {
+    Console.add("page", "Current page, page stack and registered pages", cmdPage);
+    Console.add("go", "go <name>: switch to a page", cmdGo);
+    Console.add("mem", "LVGL heap, page snapshots and page unloading", cmdMem);
+    Console.add("loop", "Loop timing, sleep, scheduler and task stats", cmdLoop);
+    Console.add("wifi", "WiFi state", cmdWiFi);
+    Console.add("weather", "Refresh the weather now", cmdWeather);
+#if DISP_STATS_LOG_MS > 0
+    Console.add("stats", "Print all stats", cmdStats);
+#endif
+    Console.add("trace", "Input record/replay (trace for usage)", cmdTrace);
+}
+#endif
+
+// One pass of the UI loop; the only place that drives LVGL
+void uiLoop() {
+    LoopWdt.beginPass();
+
+    // Results of network/audio work finished since the last pass, a few
+    // per pass (the rest wait for the next one) and before LVGL renders
+    Tasks.poll(TASK_POLL_BUDGET);
+    if (appManager) appManager->processEvents();
+
+    // Redraws only what was invalidated since the last pass
+    LoopWdt.mark(LOOP_STAGE_LVGL);
+    uint32_t lvglNext = DisplayMgr.update();
+    // Key edges captured by the interrupts since the last pass
+    LoopWdt.mark(LOOP_STAGE_INPUT);
+    InputMgr.poll();
+#if APP_CONSOLE
+    Console.poll();
+#endif
+
+    // Page timers, alarms and periodic updates
+    LoopWdt.mark(LOOP_STAGE_SCHED);
+    Sched.run();
+
+    // Sleep until the next job, LVGL timer or debounce re-check is due
+    FrameGov.update();
+#if APP_IDLE_SLEEP
+    // Key interrupts and worker results end the sleep early
+    uint32_t sleepMs = lvglNext;
+#else
+    // The governor's loop delay bounds how long a captured press waits in the ring
+    uint32_t sleepMs = FrameGov.getLoopDelay();
+    if (lvglNext < sleepMs) sleepMs = lvglNext;
+#endif
+    uint32_t schedNext = Sched.msUntilNext();
+    if (schedNext < sleepMs) sleepMs = schedNext;
+    uint32_t inputNext = InputMgr.msUntilSettle();
+    if (inputNext < sleepMs) sleepMs = inputNext;
 
-    delay(5);
+    // Heartbeat: flags a slow pass and feeds the hardware watchdog
+    LoopWdt.endPass(appManager ? appManager->getPageManager()->GetCurrentPageName() : nullptr);
+    SleepMgr.sleep(sleepMs);
+}
+
+void loop() {
+    uiLoop();
 }
 
 void setup() {
@@ -155,47 +333,28 @@ void setup() {
     delay(1000);
     Serial.println("Starting Wio Terminal LVGL App...");
 
-    // Initialize joystick pins
-    Serial.println("Initializing joystick...");
-    pinMode(JOYSTICK_UP, INPUT_PULLUP);
-    pinMode(JOYSTICK_DOWN, INPUT_PULLUP);
-    pinMode(JOYSTICK_LEFT, INPUT_PULLUP);
-    pinMode(JOYSTICK_RIGHT, INPUT_PULLUP);
-    pinMode(JOYSTICK_PRESS, INPUT_PULLUP);
-    Serial.println("Joystick initialized");
-
-    // Initialize physical button pins
-    Serial.println("Initializing physical buttons...");
-    pinMode(KEY_A_PIN, INPUT_PULLUP);
-    pinMode(KEY_B_PIN, INPUT_PULLUP);
-    pinMode(KEY_C_PIN, INPUT_PULLUP);
-    Serial.println("Physical buttons initialized");
-
-    // Initialize TFT
-    Serial.println("Initializing TFT...");
-    tft.begin();
-    tft.setRotation(3);
-    tft.fillScreen(TFT_BLACK);
-    Serial.println("TFT initialized");
-
-    // Initialize LVGL
-    Serial.println("Initializing LVGL...");
-    lv_init();
-    lv_disp_draw_buf_init(&draw_buf, buf1, NULL, 320 * 10);
-
-    lv_disp_drv_init(&disp_drv);
-    disp_drv.hor_res = 320;
-    disp_drv.ver_res = 240;
-    disp_drv.flush_cb = my_disp_flush;
-    disp_drv.draw_buf = &draw_buf;
-    lv_disp_drv_register(&disp_drv);
-    Serial.println("LVGL display driver registered");
+    // Initialize joystick and physical buttons (interrupt driven)
+    Serial.println("Initializing input...");
+    Gestures.setHandler(handleGesture);
+    InputMgr.begin(handleInputEvent);
+    Serial.println("Input initialized");
+
+    // Initialize TFT and LVGL display driver
+    Serial.println("Initializing display...");
+    if (!DisplayMgr.begin()) {
+        Serial.println("Failed to initialize display!");
+        return;
+    }
+    Serial.println("Display initialized");
 
     // Initialize style manager
     Serial.println("Initializing styles...");
     StyleManager::init();
     Serial.println("Styles initialized");
 
+    // Worker tasks first, so pages can submit network work while loading
+    Tasks.begin();
+
     // Create main container
     lv_obj_t* main_container = lv_obj_create(lv_scr_act());
     lv_obj_set_size(main_container, LV_HOR_RES, LV_VER_RES);
@@ -212,5 +371,32 @@ void setup() {
     }
     Serial.println("App Manager initialized successfully!");
 
+#if DISP_STATS_LOG_MS > 0
+    Sched.every(DISP_STATS_LOG_MS, logStats, nullptr, "stats");
+#endif
+
+#if DISP_BENCHMARK
+    DisplayBench.run(appManager);
+#endif
+
     Serial.println("Setup completed!");
+
+#if APP_CONSOLE
+    setupConsole();
+    Serial.println("Console ready, type help");
+#endif
+
+#if APP_TRACE_RECORD
+    InputTrc.startRecording();
+    Sched.every(APP_TRACE_SAVE_MS, saveTrace, nullptr, "trace");
+#endif
+#if APP_TRACE_REPLAY
+    startTraceReplay();
+#endif
+
+    // Armed last: the setup steps above may legitimately block
+    LoopWdt.begin();
+
+    // With APP_USE_RTOS this may start the scheduler and not return
+    Tasks.run(uiLoop);
 }
@@ -40,16 +40,32 @@ AIAssistantPage::AIAssistantPage() {
     lastResponse.action = "none";
     lastResponse.isValid = false;
     lastResponse.timestamp = 0;
+
+    stepJob = SCHED_INVALID_JOB;
+    pendingStep = AI_STEP_IDLE;
 }
 
 AIAssistantPage::~AIAssistantPage() {
-    // Destructor - cleanup handled by PageManager
+    // Widgets are cleaned up by PageManager
+    cancelStep();
 }
 
 void AIAssistantPage::onViewLoad() {
     Serial.println("AIAssistantPage: onViewLoad");
 }
 
+void AIAssistantPage::onViewDidLoad() {
+    Serial.println("AIAssistantPage: onViewDidLoad");
+
+    // Created with the view rather than on appear; the microphone waits for appear
+    createAIUI();
+    // Rebuilt after an unload, a request may still be in flight
+    if (currentState != AI_PROCESSING) {
+        setState(AI_IDLE);
+    }
+    updateConnectionStatus();
+}
+
 void AIAssistantPage::onViewWillAppear() {
     Serial.println("AIAssistantPage: onViewWillAppear");
 
@@ -60,13 +76,6 @@ void AIAssistantPage::onViewWillAppear() {
         micInitialized = true;
         Serial.println("AI: Microphone and config initialized");
     }
-
-    // 只在UI未创建时创建，避免重复创建
-    if (!titleLabel) {
-        createAIUI();
-        setState(AI_IDLE);
-        updateConnectionStatus();
-    }
 }
 
 void AIAssistantPage::onViewDidAppear() {
@@ -85,6 +94,33 @@ void AIAssistantPage::onViewDidDisappear() {
     Serial.println("AIAssistantPage: onViewDidDisappear");
 }
 
+void AIAssistantPage::onViewUnload() {
+    Serial.println("AIAssistantPage: onViewUnload");
+    // A reply still on screen goes with the view
+    if (cancelStep()) {
+        currentState = AI_IDLE;
+    }
+    // Objects are deleted with _root; rebuilt in onViewDidLoad
+    titleLabel = nullptr;
+    aiContainer = nullptr;
+    aiAvatar = nullptr;
+    stateLabel = nullptr;
+    responseContainer = nullptr;
+    responseText = nullptr;
+    inputContainer = nullptr;
+    inputText = nullptr;
+    modeIndicator = nullptr;
+    instructionLabel = nullptr;
+    statusBar = nullptr;
+    volumeIndicator = nullptr;
+    connectionStatus = nullptr;
+    avatarText.unbind();
+    stateText.unbind();
+    modeText.unbind();
+    instructionText.unbind();
+    connectionText.unbind();
+}
+
 void AIAssistantPage::update() {
     unsigned long currentTime = millis();
     
@@ -211,11 +247,30 @@ void AIAssistantPage::updateSoundVisualization() {
     }
 }
 
+void AIAssistantPage::onKeyA(bool pressed) {
+    // Start/stop listening
+    onButton(pressed);
+}
+
+void AIAssistantPage::onKeyB(bool pressed) {
+    (void)pressed;
+    onKey(LV_DIR_LEFT);
+}
+
+void AIAssistantPage::onKeyC(bool pressed) {
+    (void)pressed;
+    onKey(LV_DIR_RIGHT);
+}
+
+void AIAssistantPage::onTick() {
+    update();
+}
+
 void AIAssistantPage::onButton(bool pressed) {
     if (!pressed) return;
 
     // A键: 手动开始/停止监听
-    if (currentState == AI_IDLE) {
+    if (canStartRequest()) {
         startListening();
     } else if (currentState == AI_LISTENING) {
         stopListening();
@@ -228,7 +283,7 @@ void AIAssistantPage::onKey(lv_dir_t direction) {
     switch (direction) {
         case LV_DIR_TOP:
             // 摇杆按键: 手动开始/停止监听
-            if (currentState == AI_IDLE) {
+            if (canStartRequest()) {
                 startListening();
             } else if (currentState == AI_LISTENING) {
                 stopListening();
@@ -237,14 +292,14 @@ void AIAssistantPage::onKey(lv_dir_t direction) {
 
         case LV_DIR_LEFT:
             // B键: 快速天气查询 (参考Echo-Mate的指令分类)
-            if (currentState == AI_IDLE) {
+            if (canStartRequest()) {
                 executeSmartCommand("weather");
             }
             break;
 
         case LV_DIR_RIGHT:
             // C键: 快速时间查询
-            if (currentState == AI_IDLE) {
+            if (canStartRequest()) {
                 executeSmartCommand("time");
             }
             break;
@@ -255,8 +310,9 @@ void AIAssistantPage::onKey(lv_dir_t direction) {
 }
 
 void AIAssistantPage::startListening() {
-    if (currentState != AI_IDLE) return;
-    
+    if (!canStartRequest()) return;
+
+    cancelStep();
     setState(AI_LISTENING);
     startMicrophoneRecording();
     Serial.println("AI: Manual listening started");
@@ -272,26 +328,35 @@ void AIAssistantPage::stopListening() {
     Serial.println("AI: Processing voice input...");
     
     displayResponse("Processing your request...");
-    
+
+    // ASR and the AI call run on the network task; the reply comes back
+    // through the task mailbox and is shown from the UI loop
+    if (!Tasks.submit(TASK_NET, processWork, processDone, this, "ai")) {
+        processDone(this, processWork(this));
+    }
+}
+
+bool AIAssistantPage::processWork(void* ctx) {
+    AIAssistantPage* page = static_cast<AIAssistantPage*>(ctx);
+
     // 模拟语音识别和AI处理 (参考Echo-Mate的ASR+LLM流程)
-    String recognizedText = simulateASR();
-    String aiResponse = processWithAI(recognizedText);
-    
-    AIResponse response;
-    response.text = aiResponse;
-    response.action = classifyIntent(recognizedText); // 参考Echo-Mate的FastText分类
+    String recognizedText = page->simulateASR();
+    AIResponse& response = page->pendingResponse;
+    response.text = page->processWithAI(recognizedText);
+    response.action = page->classifyIntent(recognizedText); // 参考Echo-Mate的FastText分类
     response.isValid = true;
     response.timestamp = millis();
-    
-    // 使用非阻塞延迟，提高响应速度
-    unsigned long processingStart = millis();
-    while (millis() - processingStart < 500) {
-        // 允许其他任务运行
-        lv_task_handler();
-        delay(10);
-    }
+    return true;
+}
 
-    handleAIResponse(response);
+void AIAssistantPage::processDone(void* ctx, bool ok) {
+    AIAssistantPage* page = static_cast<AIAssistantPage*>(ctx);
+
+    // Cancelled (e.g. listening restarted) while the request was in flight
+    if (page->currentState != AI_PROCESSING) return;
+
+    page->pendingResponse.isValid = ok && page->pendingResponse.isValid;
+    page->handleAIResponse(page->pendingResponse);
 }
 
 // 模拟语音识别 (ASR) - 参考Echo-Mate的SenseVoice
@@ -347,21 +412,72 @@ String AIAssistantPage::classifyIntent(const String& input) {
 
 // 智能命令执行 (参考Echo-Mate的指令处理)
 void AIAssistantPage::executeSmartCommand(const String& command) {
+    cancelStep();
     setState(AI_PROCESSING);
     displayResponse("Processing " + command + " command...");
 
     // 减少延迟，提高响应速度
-    delay(200);
+    stepCommand = command;
+    scheduleStep(AI_STEP_SMART_COMMAND, 200);
+}
 
-    if (command == "weather") {
-        handleWeatherCommand();
-    } else if (command == "time") {
-        handleTimeCommand();
-    } else {
-        setState(AI_SPEAKING);
-        displayResponse("Command: " + command + " executed!");
-        delay(1500);
-        setState(AI_IDLE);
+// A reply or message is on screen and may be replaced by a new request
+bool AIAssistantPage::canStartRequest() const {
+    return currentState == AI_IDLE || currentState == AI_SPEAKING || currentState == AI_ERROR;
+}
+
+void AIAssistantPage::scheduleStep(AIStep step, uint32_t delayMs) {
+    Sched.cancel(&stepJob);
+    pendingStep = step;
+    stepJob = Sched.after(delayMs, onStepJob, this, "ai step");
+    if (stepJob == SCHED_INVALID_JOB) {
+        runStep(step); // No free slot: go on without the pause
+    }
+}
+
+bool AIAssistantPage::cancelStep() {
+    if (stepJob == SCHED_INVALID_JOB) return false;
+    Sched.cancel(&stepJob);
+    return true;
+}
+
+void AIAssistantPage::onStepJob(void* userData) {
+    AIAssistantPage* page = static_cast<AIAssistantPage*>(userData);
+    page->stepJob = SCHED_INVALID_JOB;
+    page->runStep(page->pendingStep);
+}
+
+void AIAssistantPage::runStep(AIStep step) {
+    switch (step) {
+        case AI_STEP_COMMAND:
+            executeCommand(stepCommand, "");
+            break;
+
+        case AI_STEP_SMART_COMMAND:
+            if (stepCommand == "weather") {
+                handleWeatherCommand();
+            } else if (stepCommand == "time") {
+                handleTimeCommand();
+            } else {
+                setState(AI_SPEAKING);
+                displayResponse("Command: " + stepCommand + " executed!");
+                scheduleStep(AI_STEP_IDLE, 1500);
+            }
+            break;
+
+        case AI_STEP_TEXT: {
+            AIResponse aiResponse;
+            aiResponse.text = processWithAI(stepCommand);
+            aiResponse.action = classifyIntent(stepCommand);
+            aiResponse.isValid = true;
+            aiResponse.timestamp = millis();
+            handleAIResponse(aiResponse);
+            break;
+        }
+
+        default:
+            setState(AI_IDLE);
+            break;
     }
 }
 
@@ -369,8 +485,7 @@ void AIAssistantPage::handleAIResponse(const AIResponse& response) {
     if (!response.isValid) {
         setState(AI_ERROR);
         displayResponse("Sorry, I didn't understand that.");
-        delay(1500);
-        setState(AI_IDLE);
+        scheduleStep(AI_STEP_IDLE, 1500);
         return;
     }
 
@@ -381,12 +496,11 @@ void AIAssistantPage::handleAIResponse(const AIResponse& response) {
     // 执行任何动作
     if (response.action != "none" && response.action != "chat") {
         // 减少延迟，提高响应速度
-        delay(500);
-        executeCommand(response.action, "");
+        stepCommand = response.action;
+        scheduleStep(AI_STEP_COMMAND, 500);
     } else {
         // 说话后返回idle状态，减少等待时间
-        delay(2000);
-        setState(AI_IDLE);
+        scheduleStep(AI_STEP_IDLE, 2000);
     }
 }
 
@@ -473,6 +587,12 @@ void AIAssistantPage::createAIUI() {
     lv_obj_set_style_text_font(instructionLabel, &lv_font_montserrat_14, 0);
     lv_obj_set_style_text_color(instructionLabel, lv_color_hex(0x9C27B0), 0);
 
+    avatarText.bind(aiAvatar);
+    stateText.bind(stateLabel);
+    modeText.bind(modeIndicator);
+    instructionText.bind(instructionLabel);
+    connectionText.bind(connectionStatus);
+
     updateStateDisplay();
     updateModeDisplay();
 }
@@ -480,13 +600,11 @@ void AIAssistantPage::createAIUI() {
 void AIAssistantPage::updateStateDisplay() {
     if (!stateLabel) return;
 
-    lv_label_set_text(stateLabel, getStateText(currentState));
-
-    if (aiAvatar) {
-        lv_label_set_text(aiAvatar, getAvatarSymbol(currentState));
-    }
+    // The state text is unique per state, so it also tells whether the color changed
+    bool stateChanged = stateText.setText(getStateText(currentState));
+    avatarText.setText(getAvatarSymbol(currentState));
 
-    if (aiContainer) {
+    if (aiContainer && stateChanged) {
         lv_obj_set_style_bg_color(aiContainer, getStateColor(currentState), 0);
     }
 
@@ -494,19 +612,19 @@ void AIAssistantPage::updateStateDisplay() {
     if (instructionLabel) {
         switch (currentState) {
             case AI_IDLE:
-                lv_label_set_text(instructionLabel, "A: Talk  B: Weather  C: Time");
+                instructionText.setText("A: Talk  B: Weather  C: Time");
                 break;
             case AI_LISTENING:
-                lv_label_set_text(instructionLabel, "Listening... Speak clearly!");
+                instructionText.setText("Listening... Speak clearly!");
                 break;
             case AI_PROCESSING:
-                lv_label_set_text(instructionLabel, "Processing with AI...");
+                instructionText.setText("Processing with AI...");
                 break;
             case AI_SPEAKING:
-                lv_label_set_text(instructionLabel, "AI is responding...");
+                instructionText.setText("AI is responding...");
                 break;
             case AI_ERROR:
-                lv_label_set_text(instructionLabel, "Error - Press A to retry");
+                instructionText.setText("Error - Press A to retry");
                 break;
         }
     }
@@ -515,18 +633,18 @@ void AIAssistantPage::updateStateDisplay() {
 void AIAssistantPage::updateModeDisplay() {
     if (!modeIndicator) return;
 
-    lv_label_set_text(modeIndicator, getModeText(currentMode));
+    modeText.setText(getModeText(currentMode));
 }
 
 void AIAssistantPage::updateConnectionStatus() {
     if (!connectionStatus) return;
 
     if (isConnected) {
-        lv_label_set_text(connectionStatus, LV_SYMBOL_WIFI " Online");
-        lv_obj_set_style_text_color(connectionStatus, lv_color_hex(0x4CAF50), 0);
+        connectionText.setText(LV_SYMBOL_WIFI " Online");
+        connectionText.setColor(lv_color_hex(0x4CAF50));
     } else {
-        lv_label_set_text(connectionStatus, LV_SYMBOL_WIFI " Offline");
-        lv_obj_set_style_text_color(connectionStatus, lv_color_hex(0xFF5722), 0);
+        connectionText.setText(LV_SYMBOL_WIFI " Offline");
+        connectionText.setColor(lv_color_hex(0xFF5722));
     }
 }
 
@@ -545,7 +663,7 @@ void AIAssistantPage::animateAvatar() {
         lastAnimTime = millis();
         animPhase = !animPhase;
 
-        if (currentState == AI_LISTENING && animPhase) {
+        if (currentState == AI_LISTENING && animPhase && aiContainer) {
             // 监听时的脉冲效果
             lv_obj_set_style_border_width(aiContainer, animPhase ? 5 : 3, 0);
         }
@@ -610,8 +728,7 @@ void AIAssistantPage::executeCommand(const String& command, const String& params
     } else {
         setState(AI_SPEAKING);
         displayResponse("Unknown command: " + command);
-        delay(2000);
-        setState(AI_IDLE);
+        scheduleStep(AI_STEP_IDLE, 2000);
     }
 }
 
@@ -619,8 +736,7 @@ void AIAssistantPage::handleWeatherCommand() {
     setState(AI_SPEAKING);
     displayResponse("Today: Sunny, 25°C. Perfect weather for outdoor activities!");
 
-    delay(2000);
-    setState(AI_IDLE);
+    scheduleStep(AI_STEP_IDLE, 2000);
 }
 
 void AIAssistantPage::handleTimeCommand() {
@@ -636,46 +752,35 @@ void AIAssistantPage::handleTimeCommand() {
     setState(AI_SPEAKING);
     displayResponse("Current time is " + timeStr);
 
-    delay(2000);
-    setState(AI_IDLE);
+    scheduleStep(AI_STEP_IDLE, 2000);
 }
 
 void AIAssistantPage::handleTimerCommand(const String& params) {
     setState(AI_SPEAKING);
     displayResponse("Timer command: " + params);
-    delay(2000);
-    setState(AI_IDLE);
+    scheduleStep(AI_STEP_IDLE, 2000);
 }
 
 void AIAssistantPage::handleAlarmCommand(const String& params) {
     setState(AI_SPEAKING);
     displayResponse("Alarm command: " + params);
-    delay(2000);
-    setState(AI_IDLE);
+    scheduleStep(AI_STEP_IDLE, 2000);
 }
 
 void AIAssistantPage::handleSystemCommand(const String& params) {
     setState(AI_SPEAKING);
     displayResponse("System command: " + params);
-    delay(2000);
-    setState(AI_IDLE);
+    scheduleStep(AI_STEP_IDLE, 2000);
 }
 
 void AIAssistantPage::processTextInput(const String& input) {
     Serial.printf("AI: Processing text input: %s\n", input.c_str());
+    cancelStep();
     setState(AI_PROCESSING);
     displayResponse("Processing: " + input);
 
-    delay(500);
-
-    String response = processWithAI(input);
-    AIResponse aiResponse;
-    aiResponse.text = response;
-    aiResponse.action = classifyIntent(input);
-    aiResponse.isValid = true;
-    aiResponse.timestamp = millis();
-
-    handleAIResponse(aiResponse);
+    stepCommand = input;
+    scheduleStep(AI_STEP_TEXT, 500);
 }
 
 void AIAssistantPage::loadAIConfig() {
@@ -740,8 +845,7 @@ void AIAssistantPage::speakResponse(const String& text) {
     unsigned long speakingTime = text.length() * 50; // 50ms per character
     speakingTime = constrain(speakingTime, 1000, 5000); // 1-5 seconds
 
-    delay(speakingTime);
-    setState(AI_IDLE);
+    scheduleStep(AI_STEP_IDLE, speakingTime);
 }
 
 // 音量显示
@@ -2,6 +2,9 @@
 #define AI_ASSISTANT_PAGE_H
 
 #include "../core/PageBase.h"
+#include "../core/Scheduler.h"
+#include "../core/TaskManager.h"
+#include "../utils/BoundLabel.h"
 #include <Arduino.h>
 
 // AI Assistant states
@@ -35,13 +38,19 @@ public:
 
     // PageBase interface
     virtual void onViewLoad() override;
+    virtual void onViewDidLoad() override;
     virtual void onViewWillAppear() override;
     virtual void onViewDidAppear() override;
     virtual void onViewWillDisappear() override;
     virtual void onViewDidDisappear() override;
+    virtual void onViewUnload() override;
 
     // Button handlers (using PageBase interface)
     virtual void onButton(bool pressed) override;
+    virtual void onKeyA(bool pressed) override;
+    virtual void onKeyB(bool pressed) override;
+    virtual void onKeyC(bool pressed) override;
+    virtual void onTick() override;
     virtual void onKey(lv_dir_t direction) override;
 
     // Update method
@@ -76,11 +85,17 @@ private:
     lv_obj_t* statusBar;
     lv_obj_t* volumeIndicator;
     lv_obj_t* connectionStatus;
+    BoundLabel avatarText;
+    BoundLabel stateText;
+    BoundLabel modeText;
+    BoundLabel instructionText;
+    BoundLabel connectionText;
 
     // AI state
     AIState currentState;
     AIMode currentMode;
     AIResponse lastResponse;
+    AIResponse pendingResponse;     // Filled by the network task
     String currentInput;
     bool isConnected;
     
@@ -158,7 +173,26 @@ private:
     String simulateASR();
     String processWithAI(const String& input);
     String classifyIntent(const String& input);
+    static bool processWork(void* ctx);
+    static void processDone(void* ctx, bool ok);
     void executeSmartCommand(const String& command);
+    bool canStartRequest() const;
+
+    // Pauses between states run as a scheduler job, so the reply is drawn
+    // and input keeps working while it is shown
+    enum AIStep : uint8_t {
+        AI_STEP_IDLE = 0,       // Back to idle
+        AI_STEP_COMMAND,        // executeCommand(stepCommand)
+        AI_STEP_SMART_COMMAND,  // Rest of executeSmartCommand(stepCommand)
+        AI_STEP_TEXT            // Rest of processTextInput(stepCommand)
+    };
+    void scheduleStep(AIStep step, uint32_t delayMs);
+    bool cancelStep();
+    void runStep(AIStep step);
+    static void onStepJob(void* userData);
+    int stepJob;
+    AIStep pendingStep;
+    String stepCommand;
     
     // State colors
     lv_color_t getStateColor(AIState state);
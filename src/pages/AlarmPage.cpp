@@ -27,10 +27,21 @@ AlarmPage::AlarmPage() {
     
     selectedAlarm = 0;
     editMode = false;
+
+    // Alarms are checked in the background, whichever page is shown
+    checkJob = SCHED_INVALID_JOB;
+    scheduleCheck();
+    flashJob = SCHED_INVALID_JOB;
+    flashingAlarm = -1;
+
+    // Joystick up/down change the hour in edit mode; holding them repeats
+    _Gestures.repeatKeys = GESTURE_KEY(INPUT_UP) | GESTURE_KEY(INPUT_DOWN);
 }
 
 AlarmPage::~AlarmPage() {
     // Destructor - cleanup handled by PageManager
+    Sched.cancel(&checkJob);
+    Sched.cancel(&flashJob);
 }
 
 void AlarmPage::onViewLoad() {
@@ -65,6 +76,18 @@ void AlarmPage::onViewDidDisappear() {
 
 void AlarmPage::onViewUnload() {
     Serial.println("AlarmPage: onViewUnload");
+    // Objects are deleted with _root; the check and flash jobs keep running
+    // and skip the list until onViewDidLoad builds it again
+    titleLabel = nullptr;
+    alarmList = nullptr;
+    addButton = nullptr;
+
+    for (int i = 0; i < 5; i++) {
+        alarmItems[i] = nullptr;
+        timeLabels[i] = nullptr;
+        nameLabels[i] = nullptr;
+        toggleSwitches[i] = nullptr;
+    }
 }
 
 void AlarmPage::onKey(lv_dir_t direction) {
@@ -119,6 +142,24 @@ void AlarmPage::onKey(lv_dir_t direction) {
     }
 }
 
+void AlarmPage::onKeyA(bool pressed) {
+    (void)pressed;
+    // Next alarm
+    onKey(LV_DIR_BOTTOM);
+}
+
+void AlarmPage::onKeyB(bool pressed) {
+    (void)pressed;
+    editMode = !editMode;
+    updateAlarmList();
+    Serial.printf("Alarm edit mode: %s\n", editMode ? "ON" : "OFF");
+}
+
+void AlarmPage::onKeyC(bool pressed) {
+    // Toggle the selected alarm
+    onButton(pressed);
+}
+
 void AlarmPage::onButton(bool pressed) {
     if (!pressed) return; // Only handle button press, not release
 
@@ -126,6 +167,19 @@ void AlarmPage::onButton(bool pressed) {
     toggleAlarm(selectedAlarm);
 }
 
+bool AlarmPage::onGesture(const Gesture& gesture) {
+    if (!editMode) return false;
+    if (gesture.type != GESTURE_PRESS && gesture.type != GESTURE_REPEAT) return false;
+    if (gesture.key != INPUT_UP && gesture.key != INPUT_DOWN) return false;
+
+    int hour = alarms[selectedAlarm].hour + (gesture.key == INPUT_UP ? 1 : -1);
+    if (hour > 23) hour = 0;
+    if (hour < 0) hour = 23;
+    alarms[selectedAlarm].hour = hour;
+    updateAlarmList();
+    return true;
+}
+
 void AlarmPage::createAlarmUI() {
     // Page title
     titleLabel = lv_label_create(_root);
@@ -178,6 +232,9 @@ void AlarmPage::createAlarmUI() {
 }
 
 void AlarmPage::updateAlarmList() {
+    // Alarms can be toggled while the view is unloaded
+    if (!alarmList) return;
+
     for (int i = 0; i < alarmCount; i++) {
         const Alarm& alarm = alarms[i];
         
@@ -252,16 +309,22 @@ void AlarmPage::editAlarm(int index) {
     }
 }
 
+void AlarmPage::scheduleCheck() {
+    checkJob = Sched.after(60000 - millis() % 60000, onCheckJob, this, "alarm");
+}
+
+void AlarmPage::onCheckJob(void* userData) {
+    AlarmPage* page = static_cast<AlarmPage*>(userData);
+    page->checkAlarms();
+    page->scheduleCheck();
+}
+
 void AlarmPage::checkAlarms() {
     // Simplified alarm check using millis() for demo
     // In a real implementation, you would use RTC
-    static unsigned long lastCheck = 0;
+    // Called by the scheduler at the start of every minute
     unsigned long currentTime = millis();
 
-    // Check every 60 seconds
-    if (currentTime - lastCheck < 60000) return;
-    lastCheck = currentTime;
-
     // For demo purposes, trigger alarm based on system uptime
     // You can modify this to use actual RTC time
     int simulatedHour = (currentTime / 3600000) % 24;  // Hours since startup
@@ -287,23 +350,30 @@ void AlarmPage::triggerAlarm(int index) {
         lv_obj_set_style_bg_color(alarmItems[index], lv_color_hex(0xFF0000), 0);
     }
 
-    // Audio notification using Grove Speaker
-    const int SPEAKER_PIN = A0; // Grove connector
-    pinMode(SPEAKER_PIN, OUTPUT);
-
-    // Play alarm sound pattern
-    for (int i = 0; i < 5; i++) {
-        tone(SPEAKER_PIN, 1000, 200); // 1kHz for 200ms
-        delay(300);
-        tone(SPEAKER_PIN, 800, 200);  // 800Hz for 200ms
-        delay(300);
+    // Audio notification using Grove Speaker, played by the audio task:
+    // 1kHz and 800Hz for 200ms each, five times
+    static const ToneNote alarmNotes[] = { {1000, 200, 300}, {800, 200, 300} };
+    static const TonePattern alarmPattern = { alarmNotes, 2, 5 };
+    uint32_t startMs = millis();
+    Tasks.playTones(&alarmPattern); // Blocks here without APP_USE_RTOS
+    uint32_t elapsedMs = millis() - startMs;
+
+    // Reset visual notification 3 seconds after the sound ends
+    if (flashingAlarm >= 0 && flashingAlarm != index && alarmItems[flashingAlarm]) {
+        lv_obj_set_style_bg_color(alarmItems[flashingAlarm], lv_color_hex(0xF8F8F8), 0);
     }
-    noTone(SPEAKER_PIN);
+    flashingAlarm = index;
+    Sched.cancel(&flashJob);
+    flashJob = Sched.after(elapsedMs < 6000 ? 6000 - elapsedMs : 0, onFlashEndJob, this, "flash");
+}
 
-    // Reset visual notification after 3 seconds
-    // Note: In a real implementation, you'd use a timer callback
-    delay(3000);
-    if (alarmItems[index]) {
-        lv_obj_set_style_bg_color(alarmItems[index], lv_color_hex(0xF8F8F8), 0);
+void AlarmPage::onFlashEndJob(void* userData) {
+    AlarmPage* page = static_cast<AlarmPage*>(userData);
+    page->flashJob = SCHED_INVALID_JOB;
+
+    int index = page->flashingAlarm;
+    page->flashingAlarm = -1;
+    if (index >= 0 && page->alarmItems[index]) {
+        lv_obj_set_style_bg_color(page->alarmItems[index], lv_color_hex(0xF8F8F8), 0);
     }
 }
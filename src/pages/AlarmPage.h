@@ -1,6 +1,8 @@
 #pragma once
 
 #include "../core/PageBase.h"
+#include "../core/Scheduler.h"
+#include "../core/TaskManager.h"
 
 class AlarmPage : public PageBase {
 public:
@@ -17,6 +19,10 @@ public:
 
     virtual void onKey(lv_dir_t direction) override;
     virtual void onButton(bool pressed) override;
+    virtual void onKeyA(bool pressed) override;
+    virtual void onKeyB(bool pressed) override;
+    virtual void onKeyC(bool pressed) override;
+    virtual bool onGesture(const Gesture& gesture) override;
 
     // Public members for AppManager access
     bool editMode;
@@ -28,6 +34,9 @@ private:
     void toggleAlarm(int index);
     void editAlarm(int index);
     void triggerAlarm(int index); // Trigger alarm notification
+    void scheduleCheck();
+    static void onCheckJob(void* userData);
+    static void onFlashEndJob(void* userData);
 
 private:
     lv_obj_t* titleLabel;
@@ -39,6 +48,9 @@ private:
     lv_obj_t* addButton;
 
     int selectedAlarm;
+    int checkJob;         // Fires on every minute boundary
+    int flashJob;         // Clears the triggered alarm's highlight
+    int flashingAlarm;
 
     struct Alarm {
         int hour;
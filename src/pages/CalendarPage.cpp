@@ -24,12 +24,12 @@ CalendarPage::CalendarPage() {
     // Initialize RTC and get current time
     initializeRTC();
 
-    // ???????????????
-    lastTimeUpdate = 0;
+    clockJob = Sched.every(TIME_UPDATE_INTERVAL, onClockJob, this, "clock");
 }
 
 CalendarPage::~CalendarPage() {
     // Destructor - cleanup handled by PageManager
+    Sched.cancel(&clockJob);
 }
 
 void CalendarPage::initializeRTC() {
@@ -76,9 +76,7 @@ void CalendarPage::updateCurrentTime() {
     currentMinute = now.minute();
 
     // Update time display
-    if (timeLabel) {
-        lv_label_set_text_fmt(timeLabel, "%02d:%02d", currentHour, currentMinute);
-    }
+    timeText.setTextFmt("%02d:%02d", currentHour, currentMinute);
 
     Serial.printf("Time updated: %04d-%02d-%02d %02d:%02d\n",
                   currentYear, currentMonth, currentDay, currentHour, currentMinute);
@@ -117,7 +115,23 @@ void CalendarPage::onViewDidDisappear() {
 
 void CalendarPage::onViewUnload() {
     Serial.println("CalendarPage: onViewUnload");
-    // Objects will be automatically deleted with _root
+    // Objects are deleted with _root; the clock job keeps running, so drop
+    // every pointer into the tree and rebuild it in onViewDidLoad
+    titleLabel = nullptr;
+    timeLabel = nullptr;
+    monthLabel = nullptr;
+    calendarGrid = nullptr;
+    timeText.unbind();
+    monthText.unbind();
+
+    for (int i = 0; i < 7; i++) {
+        dayLabels[i] = nullptr;
+    }
+
+    for (int i = 0; i < 42; i++) {
+        dateLabels[i] = nullptr;
+        dateTexts[i].unbind();
+    }
 }
 
 void CalendarPage::onKey(lv_dir_t direction) {
@@ -172,38 +186,36 @@ void CalendarPage::onButton(bool pressed) {
     }
 }
 
-void CalendarPage::update() {
-    // ???????????????????
-    unsigned long currentMillis = millis();
-    if (currentMillis - lastTimeUpdate >= TIME_UPDATE_INTERVAL) {
-        lastTimeUpdate = currentMillis;
-
-        // ??????????
-        DateTime now = rtc.now();
-        int newHour = now.hour();
-        int newMinute = now.minute();
-
-        // ???????????????????
-        if (newHour != currentHour || newMinute != currentMinute) {
-            currentHour = newHour;
-            currentMinute = newMinute;
-
-            // ?????????
-            if (timeLabel) {
-                lv_label_set_text_fmt(timeLabel, "%02d:%02d", currentHour, currentMinute);
-            }
+void CalendarPage::onClockJob(void* userData) {
+    static_cast<CalendarPage*>(userData)->update();
+}
 
-            // ?????????????????????????
-            int newYear = now.year();
-            int newMonth = now.month();
-            int newDay = now.day();
+void CalendarPage::update() {
+    // Runs every TIME_UPDATE_INTERVAL from the scheduler
 
-            if (newYear != currentYear || newMonth != currentMonth || newDay != currentDay) {
-                currentYear = newYear;
-                currentMonth = newMonth;
-                currentDay = newDay;
-                updateCalendar(); // ??????????
-            }
+    // ??????????
+    DateTime now = rtc.now();
+    int newHour = now.hour();
+    int newMinute = now.minute();
+
+    // ???????????????????
+    if (newHour != currentHour || newMinute != currentMinute) {
+        currentHour = newHour;
+        currentMinute = newMinute;
+
+        // ?????????
+        timeText.setTextFmt("%02d:%02d", currentHour, currentMinute);
+
+        // ?????????????????????????
+        int newYear = now.year();
+        int newMonth = now.month();
+        int newDay = now.day();
+
+        if (newYear != currentYear || newMonth != currentMonth || newDay != currentDay) {
+            currentYear = newYear;
+            currentMonth = newMonth;
+            currentDay = newDay;
+            updateCalendar(); // ??????????
         }
     }
 }
@@ -222,12 +234,14 @@ void CalendarPage::createCalendarUI() {
     lv_obj_align(timeLabel, LV_ALIGN_TOP_RIGHT, -10, 5);
     lv_obj_set_style_text_font(timeLabel, &lv_font_montserrat_14, 0);
     lv_obj_set_style_text_color(timeLabel, lv_color_hex(0x007AFF), 0);
+    timeText.bind(timeLabel);
 
     // Month/Year display
     monthLabel = lv_label_create(_root);
     lv_obj_align(monthLabel, LV_ALIGN_TOP_MID, 0, 25);
     lv_obj_set_style_text_font(monthLabel, &lv_font_montserrat_14, 0);
     lv_obj_set_style_text_color(monthLabel, lv_color_hex(0x333333), 0);
+    monthText.bind(monthLabel);
 
     // Calendar grid container
     calendarGrid = lv_obj_create(_root);
@@ -260,6 +274,7 @@ void CalendarPage::createCalendarUI() {
         lv_obj_set_pos(dateLabels[i], col * 35 + 12, 25 + row * 20);
         lv_obj_set_style_text_font(dateLabels[i], &lv_font_montserrat_14, 0);
         lv_obj_set_style_text_color(dateLabels[i], lv_color_hex(0x333333), 0);
+        dateTexts[i].bind(dateLabels[i]);
     }
 
     // No instructions needed
@@ -274,7 +289,7 @@ void CalendarPage::updateCalendar() {
         "July", "August", "September", "October", "November", "December"
     };
     
-    lv_label_set_text_fmt(monthLabel, "%s %d", monthNames[currentMonth - 1], currentYear);
+    monthText.setTextFmt("%s %d", monthNames[currentMonth - 1], currentYear);
 
     // Calculate first day of month and number of days
     struct tm timeinfo = {0};
@@ -297,26 +312,26 @@ void CalendarPage::updateCalendar() {
     
     int daysThisMonth = daysInMonth[currentMonth - 1];
 
-    // Clear all date labels
+    // Fill in the dates; labels that already show the right day are left alone
+    DateTime now = rtc.now();
     for (int i = 0; i < 42; i++) {
-        lv_label_set_text(dateLabels[i], "");
-        lv_obj_set_style_text_color(dateLabels[i], lv_color_hex(0x333333), 0);
-    }
+        int day = i - startDayOfWeek + 1;
+        bool inMonth = day >= 1 && day <= daysThisMonth;
+        if (inMonth) {
+            dateTexts[i].setTextFmt("%d", day);
+        } else {
+            dateTexts[i].setText("");
+        }
 
-    // Fill in the dates
-    for (int day = 1; day <= daysThisMonth; day++) {
-        int position = startDayOfWeek + day - 1;
-        if (position < 42) {
-            lv_label_set_text_fmt(dateLabels[position], "%d", day);
-            
-            // Highlight today (using RTC current date)
-            DateTime now = rtc.now();
-            if (currentYear == now.year() && currentMonth == now.month() && day == now.day()) {
-                lv_obj_set_style_text_color(dateLabels[position], lv_color_hex(0x007AFF), 0);
-                lv_obj_set_style_bg_color(dateLabels[position], lv_color_hex(0xE6F3FF), 0);
-                lv_obj_set_style_bg_opa(dateLabels[position], LV_OPA_COVER, 0);
-                lv_obj_set_style_radius(dateLabels[position], 3, 0);
+        // Highlight today (using RTC current date)
+        if (inMonth && currentYear == now.year() && currentMonth == now.month() && day == now.day()) {
+            if (dateTexts[i].setColor(lv_color_hex(0x007AFF))) {
+                lv_obj_set_style_bg_color(dateLabels[i], lv_color_hex(0xE6F3FF), 0);
+                lv_obj_set_style_bg_opa(dateLabels[i], LV_OPA_COVER, 0);
+                lv_obj_set_style_radius(dateLabels[i], 3, 0);
             }
+        } else if (dateTexts[i].setColor(lv_color_hex(0x333333))) {
+            lv_obj_set_style_bg_opa(dateLabels[i], LV_OPA_TRANSP, 0);
         }
     }
 
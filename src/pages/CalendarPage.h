@@ -11,6 +11,8 @@
 
 #include "../core/PageBase.h"
 #include "../theme/style_manager.h"
+#include "../utils/BoundLabel.h"
+#include "../core/Scheduler.h"
 
 class CalendarPage : public PageBase {
 public:
@@ -36,6 +38,7 @@ private:
     void updateCalendar();
     void initializeRTC();
     void updateCurrentTime();
+    static void onClockJob(void* userData);
 
 private:
     lv_obj_t* titleLabel;
@@ -44,6 +47,9 @@ private:
     lv_obj_t* calendarGrid;
     lv_obj_t* dayLabels[7];
     lv_obj_t* dateLabels[42]; // 6 weeks * 7 days
+    BoundLabel timeText;
+    BoundLabel monthText;
+    BoundLabel dateTexts[42];
 
     int currentYear;
     int currentMonth;
@@ -52,6 +58,6 @@ private:
     int currentMinute;
 
     // ʱˢ
-    unsigned long lastTimeUpdate;
+    int clockJob;
     static const unsigned long TIME_UPDATE_INTERVAL = 1000; // 1һ
 };
@@ -23,6 +23,9 @@ MemoPage::MemoPage() {
         memoContents[i] = nullptr;
         memoIcons[i] = nullptr;
     }
+    detailView = nullptr;
+    detailTitle = nullptr;
+    detailContent = nullptr;
     
     selectedMemo = 0;
     viewMode = false; // Start in grid mode
@@ -64,6 +67,19 @@ void MemoPage::onViewDidDisappear() {
 
 void MemoPage::onViewUnload() {
     Serial.println("MemoPage: onViewUnload");
+    // Objects are deleted with _root; rebuilt in onViewDidLoad
+    titleLabel = nullptr;
+    memoGrid = nullptr;
+    detailView = nullptr;
+    detailTitle = nullptr;
+    detailContent = nullptr;
+
+    for (int i = 0; i < 6; i++) {
+        memoCards[i] = nullptr;
+        memoTitles[i] = nullptr;
+        memoContents[i] = nullptr;
+        memoIcons[i] = nullptr;
+    }
 }
 
 void MemoPage::onKey(lv_dir_t direction) {
@@ -122,6 +138,22 @@ void MemoPage::onKey(lv_dir_t direction) {
     }
 }
 
+void MemoPage::onKeyA(bool pressed) {
+    (void)pressed;
+    // Next memo
+    onKey(LV_DIR_BOTTOM);
+}
+
+void MemoPage::onKeyB(bool pressed) {
+    onButton(pressed);
+}
+
+void MemoPage::onKeyC(bool pressed) {
+    (void)pressed;
+    // Previous memo
+    onKey(LV_DIR_TOP);
+}
+
 void MemoPage::onButton(bool pressed) {
     if (!pressed) return; // Only handle button press, not release
 
@@ -194,11 +226,6 @@ void MemoPage::createMemoUI() {
 }
 
 void MemoPage::updateMemoDisplay() {
-    // Use member variables instead of static to avoid persistence issues
-    static lv_obj_t* detailView = nullptr;
-    static lv_obj_t* detailTitle = nullptr;
-    static lv_obj_t* detailContent = nullptr;
-
     if (viewMode) {
         // Hide grid, show detailed view
         lv_obj_add_flag(memoGrid, LV_OBJ_FLAG_HIDDEN);
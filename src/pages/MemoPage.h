@@ -18,6 +18,9 @@ public:
 
     virtual void onKey(lv_dir_t direction) override;
     virtual void onButton(bool pressed) override;
+    virtual void onKeyA(bool pressed) override;
+    virtual void onKeyB(bool pressed) override;
+    virtual void onKeyC(bool pressed) override;
 
 private:
     void createMemoUI();
@@ -32,6 +35,9 @@ private:
     lv_obj_t* memoTitles[6];
     lv_obj_t* memoContents[6];
     lv_obj_t* memoIcons[6];
+    lv_obj_t* detailView;       // Created on first use of the view mode
+    lv_obj_t* detailTitle;
+    lv_obj_t* detailContent;
     
     int selectedMemo;
     bool viewMode; // true = view, false = grid
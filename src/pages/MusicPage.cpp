@@ -23,7 +23,7 @@ MusicPage::MusicPage() {
     currentTrack = 0;
     currentTime = 0;
     totalTime = 180;
-    lastUpdateTime = 0; // Default 3 minutes
+    progressJob = SCHED_INVALID_JOB;
     trackCount = 0;
     sdCardAvailable = false;
 
@@ -34,6 +34,7 @@ MusicPage::MusicPage() {
 
 MusicPage::~MusicPage() {
     // Destructor - cleanup handled by PageManager
+    Sched.cancel(&progressJob);
 }
 
 void MusicPage::onViewLoad() {
@@ -46,7 +47,10 @@ void MusicPage::onViewLoad() {
 
 void MusicPage::onViewDidLoad() {
     Serial.println("MusicPage: onViewDidLoad");
-    loadMusicFiles();
+    // The track list outlives the view; a rebuild after an unload keeps it
+    if (trackCount == 0) {
+        loadMusicFiles();
+    }
     createMusicUI();
 }
 
@@ -70,6 +74,18 @@ void MusicPage::onViewDidDisappear() {
 
 void MusicPage::onViewUnload() {
     Serial.println("MusicPage: onViewUnload");
+    // Objects are deleted with _root; playback keeps running and the
+    // progress job skips the view until onViewDidLoad builds it again
+    titleLabel = nullptr;
+    albumCover = nullptr;
+    coverIcon = nullptr;
+    trackTitle = nullptr;
+    artistLabel = nullptr;
+    timeLabel = nullptr;
+    timeText.unbind();
+    statusLabel = nullptr;
+    progressBar = nullptr;
+    playButton = nullptr;
 }
 
 void MusicPage::onKey(lv_dir_t direction) {
@@ -124,6 +140,23 @@ void MusicPage::onKey(lv_dir_t direction) {
     }
 }
 
+void MusicPage::onKeyA(bool pressed) {
+    // Play/pause
+    onButton(pressed);
+}
+
+void MusicPage::onKeyB(bool pressed) {
+    (void)pressed;
+    // Next track
+    onKey(LV_DIR_RIGHT);
+}
+
+void MusicPage::onKeyC(bool pressed) {
+    (void)pressed;
+    // Previous track
+    onKey(LV_DIR_LEFT);
+}
+
 void MusicPage::onButton(bool pressed) {
     if (!pressed) return; // Only handle button press, not release
 
@@ -181,6 +214,7 @@ void MusicPage::createMusicUI() {
     lv_obj_align(timeLabel, LV_ALIGN_TOP_MID, 0, 190);
     lv_obj_set_style_text_font(timeLabel, &lv_font_montserrat_14, 0);
     lv_obj_set_style_text_color(timeLabel, lv_color_hex(0x888888), 0);
+    timeText.bind(timeLabel);
 
     // Progress bar
     progressBar = lv_bar_create(_root);
@@ -277,8 +311,7 @@ void MusicPage::updateProgress() {
     int totalMin = totalTime / 60;
     int totalSec = totalTime % 60;
 
-    lv_label_set_text_fmt(timeLabel, "%d:%02d / %d:%02d",
-                          currentMin, currentSec, totalMin, totalSec);
+    timeText.setTextFmt("%d:%02d / %d:%02d", currentMin, currentSec, totalMin, totalSec);
 }
 
 void MusicPage::updateTimeDisplay() {
@@ -290,8 +323,7 @@ void MusicPage::updateTimeDisplay() {
     int totalMin = totalTime / 60;
     int totalSec = totalTime % 60;
 
-    lv_label_set_text_fmt(timeLabel, "%d:%02d / %d:%02d",
-                          currentMin, currentSec, totalMin, totalSec);
+    timeText.setTextFmt("%d:%02d / %d:%02d", currentMin, currentSec, totalMin, totalSec);
 }
 
 void MusicPage::loadMusicFiles() {
@@ -379,44 +411,47 @@ void MusicPage::loadMusicFiles() {
     Serial.printf("Loaded %d music tracks (SD Card: %s)\n", trackCount, sdCardAvailable ? "Yes" : "No");
 }
 
+// Start tone and per-melody previews, played by the audio task
+static const ToneNote startNotes[] = { {1000, 500, 600} };
+static const TonePattern startPattern = { startNotes, 1, 1 };
+
+static const ToneNote previewNotes[][3] = {
+    { {262, 200, 250}, {294, 200, 250}, {330, 200, 250} }, // C major
+    { {440, 200, 250}, {494, 200, 250}, {523, 200, 250} }, // A major
+    { {330, 200, 250}, {370, 200, 250}, {415, 200, 250} }, // E major
+    { {392, 200, 250}, {440, 200, 250}, {494, 200, 250} }, // G major
+    { {294, 200, 250}, {330, 200, 250}, {370, 200, 250} }  // D major
+};
+static const TonePattern previewPatterns[] = {
+    { previewNotes[0], 3, 1 },
+    { previewNotes[1], 3, 1 },
+    { previewNotes[2], 3, 1 },
+    { previewNotes[3], 3, 1 },
+    { previewNotes[4], 3, 1 }
+};
+
 void MusicPage::playCurrentTrack() {
     if (currentTrack >= trackCount) return;
 
     Serial.printf("Playing track: %s\n", musicFiles[currentTrack]);
 
-    // Initialize Grove Speaker
-    pinMode(SPEAKER_PIN, OUTPUT);
-
     if (isPlaying) {
         if (sdCardAvailable) {
             // WAV file playback
             Serial.printf("Playing WAV file: %s\n", musicFiles[currentTrack]);
 
             // Play start tone
-            tone(SPEAKER_PIN, 1000, 500);
-            delay(600);
+            Tasks.playTones(&startPattern);
 
             // Estimate duration from file size
             totalTime = 180 + (currentTrack * 30); // Default duration
 
         } else {
             // Demo mode with different melodies
-            const int melodies[][6] = {
-                {262, 294, 330, 349, 392, 440}, // C major
-                {440, 494, 523, 587, 659, 698}, // A major
-                {330, 370, 415, 440, 494, 554}, // E major
-                {392, 440, 494, 523, 587, 659}, // G major
-                {294, 330, 370, 392, 440, 494}  // D major
-            };
-
             int melodyIndex = currentTrack % 5;
-            const int* melody = melodies[melodyIndex];
 
             // Play melody preview
-            for (int i = 0; i < 3; i++) {
-                tone(SPEAKER_PIN, melody[i], 200);
-                delay(250);
-            }
+            Tasks.playTones(&previewPatterns[melodyIndex]);
 
             totalTime = 180 + (currentTrack * 30);
             Serial.printf("Demo mode: Playing melody pattern %d\n", melodyIndex);
@@ -424,33 +459,36 @@ void MusicPage::playCurrentTrack() {
 
         // Initialize playback state
         currentTime = 0;
-        lastUpdateTime = millis();
+        Sched.cancel(&progressJob);
+        progressJob = Sched.every(1000, onProgressJob, this, "music");
     }
 }
 
+void MusicPage::onProgressJob(void* userData) {
+    static_cast<MusicPage*>(userData)->updatePlaybackProgress();
+}
+
 void MusicPage::updatePlaybackProgress() {
+    // Runs every second from the scheduler while a track is playing
     if (isPlaying && totalTime > 0) {
-        unsigned long now = millis();
-        if (now - lastUpdateTime >= 1000) { // ?????????
-            currentTime++;
-            lastUpdateTime = now;
-
-            // ????????????????
-            if (currentTime >= totalTime) {
-                isPlaying = false;
-                currentTime = totalTime;
-                stopCurrentTrack();
-                Serial.println("Track finished");
-            }
-
-            // ??????????
-            updateProgress();
+        currentTime++;
+
+        // ????????????????
+        if (currentTime >= totalTime) {
+            isPlaying = false;
+            currentTime = totalTime;
+            stopCurrentTrack();
+            Serial.println("Track finished");
         }
+
+        // ??????????
+        updateProgress();
     }
 }
 
 void MusicPage::stopCurrentTrack() {
     Serial.println("Stopping current track");
-    noTone(SPEAKER_PIN);
+    Sched.cancel(&progressJob);
+    Tasks.stopTones();
     digitalWrite(SPEAKER_PIN, LOW);
 }
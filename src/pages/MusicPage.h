@@ -3,6 +3,9 @@
 #include <Arduino.h>
 #include "../core/PageBase.h"
 #include "../theme/style_manager.h"
+#include "../utils/BoundLabel.h"
+#include "../core/Scheduler.h"
+#include "../core/TaskManager.h"
 
 class MusicPage : public PageBase {
 public:
@@ -19,7 +22,9 @@ public:
 
     virtual void onKey(lv_dir_t direction) override;
     virtual void onButton(bool pressed) override;
-    void updatePlaybackProgress(); //  AppManager 
+    virtual void onKeyA(bool pressed) override;
+    virtual void onKeyB(bool pressed) override;
+    virtual void onKeyC(bool pressed) override;
 
 private:
     void createMusicUI();
@@ -28,6 +33,8 @@ private:
     void updateTimeDisplay();
     void playCurrentTrack();
     void stopCurrentTrack();
+    void updatePlaybackProgress();
+    static void onProgressJob(void* userData);
 
 private:
     lv_obj_t* titleLabel;
@@ -36,6 +43,7 @@ private:
     lv_obj_t* trackTitle;
     lv_obj_t* artistLabel;
     lv_obj_t* timeLabel;
+    BoundLabel timeText;     // Bound to timeLabel
     lv_obj_t* statusLabel;
     lv_obj_t* progressBar;
     lv_obj_t* playButton; // Status display only
@@ -44,7 +52,7 @@ private:
     int currentTrack;
     int currentTime; // in seconds
     int totalTime;   // in seconds
-    unsigned long lastUpdateTime; // for progress simulation
+    int progressJob;      // 1 s progress job while playing
 
     // Music management
     static const int MAX_TRACKS = 10;
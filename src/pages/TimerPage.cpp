@@ -8,16 +8,22 @@ TimerPage::TimerPage() {
     timerDisplay = nullptr;
     statusLabel = nullptr;
     instructionLabel = nullptr;
+    progressArc = nullptr;
 
     // ????????????
     isRunning = false;
-    totalMinutes = 5;        // ???5????
+    totalMinutes = TIMER_DEFAULT_MINUTES; // ???5????
     remainingSeconds = totalMinutes * 60;
-    lastUpdateTime = 0;
+    tickJob = SCHED_INVALID_JOB;
+
+    // Hold A to reset, hold B/C to adjust quickly, B+C for the default time
+    _Gestures.longPressKeys = GESTURE_KEY(INPUT_KEY_A);
+    _Gestures.repeatKeys = GESTURE_KEY(INPUT_KEY_B) | GESTURE_KEY(INPUT_KEY_C);
+    _Gestures.chords[0] = GESTURE_KEY(INPUT_KEY_B) | GESTURE_KEY(INPUT_KEY_C);
 }
 
 TimerPage::~TimerPage() {
-    // Destructor
+    Sched.cancel(&tickJob);
 }
 
 void TimerPage::onViewLoad() {
@@ -51,6 +57,15 @@ void TimerPage::onViewDidDisappear() {
 
 void TimerPage::onViewUnload() {
     Serial.println("TimerPage: onViewUnload");
+    // Objects are deleted with _root; a running countdown keeps ticking and
+    // is shown again once onViewDidLoad rebuilds the view
+    titleLabel = nullptr;
+    timerDisplay = nullptr;
+    statusLabel = nullptr;
+    instructionLabel = nullptr;
+    progressArc = nullptr;
+    timerText.unbind();
+    statusText.unbind();
 }
 
 void TimerPage::onKey(lv_dir_t direction) {
@@ -130,66 +145,69 @@ void TimerPage::createTimerUI() {
     lv_obj_set_style_text_font(statusLabel, &lv_font_montserrat_14, 0);
     lv_obj_set_style_text_color(statusLabel, lv_color_hex(0xF57C00), 0);
 
+    timerText.bind(timerDisplay);
+    statusText.bind(statusLabel);
 
     updateTimerDisplay();
 }
 
-void TimerPage::updateTimerDisplay() {
-    // ???????????
-    if (isRunning) {
-        unsigned long currentTime = millis();
-        if (currentTime - lastUpdateTime >= 1000) { // ??????
-            remainingSeconds--;
-            lastUpdateTime = currentTime;
-
-            if (remainingSeconds <= 0) {
-                // ?????
-                isRunning = false;
-                remainingSeconds = 0;
-                lv_label_set_text(timerDisplay, "00:00");
-                lv_label_set_text(statusLabel, " Time's Up!");
-                lv_obj_set_style_text_color(statusLabel, lv_color_hex(0xFF0000), 0);
-
-                // ?????????
-                const int SPEAKER_PIN = A0;
-                pinMode(SPEAKER_PIN, OUTPUT);
-                for (int i = 0; i < 3; i++) {
-                    tone(SPEAKER_PIN, 1200, 300);
-                    delay(400);
-                }
-                noTone(SPEAKER_PIN);
-
-                // Timer finished
-                return;
-            }
-        }
+void TimerPage::onTickJob(void* userData) {
+    static_cast<TimerPage*>(userData)->tick();
+}
+
+void TimerPage::tick() {
+    // Runs every second from the scheduler while the timer is running,
+    // also when the page is not shown
+    if (!isRunning) return;
+
+    remainingSeconds--;
+    if (remainingSeconds <= 0) {
+        // ?????
+        isRunning = false;
+        remainingSeconds = 0;
+        Sched.cancel(&tickJob);
+        timerText.setText("00:00");
+        statusText.setText(" Time's Up!");
+        statusText.setColor(lv_color_hex(0xFF0000));
+
+        // ?????????
+        static const ToneNote finishNotes[] = { {1200, 300, 400} };
+        static const TonePattern finishPattern = { finishNotes, 1, 3 };
+        Tasks.playTones(&finishPattern);
+
+        // Timer finished
+        return;
     }
 
+    updateTimerDisplay();
+}
+
+void TimerPage::updateTimerDisplay() {
     // ??????????
     int minutes = remainingSeconds / 60;
     int seconds = remainingSeconds % 60;
-    lv_label_set_text_fmt(timerDisplay, "%02d:%02d", minutes, seconds);
+    timerText.setTextFmt("%02d:%02d", minutes, seconds);
 
     // ??????ν?????
     int totalSeconds = totalMinutes * 60;
-    if (totalSeconds > 0) {
+    if (totalSeconds > 0 && progressArc) {
         int progressValue = (remainingSeconds * 300) / totalSeconds; // ???0-300??Χ
         lv_arc_set_value(progressArc, progressValue);
     }
 
     // Update status (?????)
     if (isRunning) {
-        lv_label_set_text(statusLabel, "Running");
-        lv_obj_set_style_text_color(statusLabel, lv_color_hex(0x4CAF50), 0);
+        statusText.setText("Running");
+        statusText.setColor(lv_color_hex(0x4CAF50));
     } else {
         if (remainingSeconds > 0) {
-            lv_label_set_text(statusLabel, "Ready");
+            statusText.setText("Ready");
         } else {
-            lv_label_set_text(statusLabel, "Finished");
-            lv_obj_set_style_text_color(statusLabel, lv_color_hex(0xFF5722), 0);
+            statusText.setText("Finished");
+            statusText.setColor(lv_color_hex(0xFF5722));
         }
         if (remainingSeconds > 0) {
-            lv_obj_set_style_text_color(statusLabel, lv_color_hex(0xF57C00), 0);
+            statusText.setColor(lv_color_hex(0xF57C00));
         }
     }
 }
@@ -200,12 +218,13 @@ void TimerPage::startStopTimer() {
     if (isRunning) {
         // ????????
         isRunning = false;
+        Sched.cancel(&tickJob);
         Serial.println("Timer paused");
     } else {
         // ????????
         if (remainingSeconds > 0) {
             isRunning = true;
-            lastUpdateTime = millis();
+            tickJob = Sched.every(1000, onTickJob, this, "timer");
             Serial.println("Timer started");
         }
     }
@@ -214,6 +233,7 @@ void TimerPage::startStopTimer() {
 
 void TimerPage::resetTimer() {
     isRunning = false;
+    Sched.cancel(&tickJob);
     remainingSeconds = totalMinutes * 60;
     updateTimerDisplay();
     Serial.println("Timer reset");
@@ -221,20 +241,14 @@ void TimerPage::resetTimer() {
 
 // ??? switchMode ???? - ???????
 
-void TimerPage::updateTimer() {
-    if (isRunning) {
-        updateTimerDisplay();
-    }
-}
-
-void TimerPage::onButtonA(bool pressed) {
+void TimerPage::onKeyA(bool pressed) {
     if (!pressed) return;
     // A???????/????????
     startStopTimer();
     Serial.printf("Timer A: %s\n", isRunning ? "Started" : "Stopped");
 }
 
-void TimerPage::onButtonB(bool pressed) {
+void TimerPage::onKeyB(bool pressed) {
     if (!pressed) return;
     // B??????????? (+1????)
     if (!isRunning) {
@@ -243,7 +257,7 @@ void TimerPage::onButtonB(bool pressed) {
     }
 }
 
-void TimerPage::onButtonC(bool pressed) {
+void TimerPage::onKeyC(bool pressed) {
     if (!pressed) return;
     // C??????????? (-1????)
     if (!isRunning) {
@@ -252,6 +266,37 @@ void TimerPage::onButtonC(bool pressed) {
     }
 }
 
+bool TimerPage::onGesture(const Gesture& gesture) {
+    switch (gesture.type) {
+        case GESTURE_LONG_PRESS:
+            if (gesture.key != INPUT_KEY_A) return false;
+            resetTimer();
+            return true;
+
+        case GESTURE_REPEAT: {
+            if (isRunning) return true;
+            // 1 minute per repeat, 5 once the key has been held a while
+            int step = gesture.count > 10 ? 5 : 1;
+            if (gesture.key == INPUT_KEY_B) {
+                adjustTime(step);
+            } else if (gesture.key == INPUT_KEY_C) {
+                adjustTime(-step);
+            } else {
+                return false;
+            }
+            return true;
+        }
+
+        case GESTURE_CHORD:
+            totalMinutes = TIMER_DEFAULT_MINUTES;
+            resetTimer();
+            return true;
+
+        default:
+            return false;
+    }
+}
+
 void TimerPage::adjustTime(int minutes) {
     if (isRunning) {
         Serial.println("Cannot adjust time while timer is running");
@@ -2,6 +2,11 @@
 
 #include "../core/PageBase.h"
 #include "../theme/style_manager.h"
+#include "../utils/BoundLabel.h"
+#include "../core/Scheduler.h"
+#include "../core/TaskManager.h"
+
+#define TIMER_DEFAULT_MINUTES 5
 
 class TimerPage : public PageBase {
 public:
@@ -18,19 +23,21 @@ public:
 
     virtual void onKey(lv_dir_t direction) override;
     virtual void onButton(bool pressed) override;
-    void onButtonA(bool pressed);
-    void onButtonB(bool pressed);
-    void onButtonC(bool pressed);
+    virtual void onKeyA(bool pressed) override;
+    virtual void onKeyB(bool pressed) override;
+    virtual void onKeyC(bool pressed) override;
+    virtual bool onGesture(const Gesture& gesture) override;
 
     // Public methods for AppManager access
     void resetTimer();
-    void updateTimer(); // Called periodically to update display
     void adjustTime(int minutes); // ???????
 
 private:
     void createTimerUI();
     void updateTimerDisplay();
     void startStopTimer();
+    void tick();
+    static void onTickJob(void* userData);
 
 private:
     // UI ???
@@ -39,10 +46,12 @@ private:
     lv_obj_t* statusLabel;
     lv_obj_t* instructionLabel;
     lv_obj_t* progressArc;
+    BoundLabel timerText;    // Bound to timerDisplay
+    BoundLabel statusText;   // Bound to statusLabel
 
     // ???????
     bool isRunning;
     int totalMinutes;        // ???????????????
     int remainingSeconds;    // ????????
-    unsigned long lastUpdateTime; // ?????????
+    int tickJob;             // 1 s countdown job while running
 };
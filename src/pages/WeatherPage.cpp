@@ -26,6 +26,7 @@ WeatherPage::WeatherPage() {
     
     // Initialize weather data
     currentWeather.isValid = false;
+    pendingWeather.isValid = false;
     lastUpdateTime = 0;
     isUpdating = false;
     
@@ -45,16 +46,21 @@ void WeatherPage::onViewLoad() {
     lv_obj_set_style_bg_opa(_root, LV_OPA_COVER, 0);
 }
 
+void WeatherPage::onViewDidLoad() {
+    Serial.println("WeatherPage: onViewDidLoad");
+
+    // Part of loading, so the preloader can build it before the page is shown
+    createWeatherUI();
+    // 显示默认数据，避免阻塞页面切换
+    displayDefaultWeatherInfo();
+    // Rebuilt after an unload: show what was fetched before
+    displayWeatherInfo();
+    showLoadingIndicator(isUpdating);
+}
+
 void WeatherPage::onViewWillAppear() {
     Serial.println("WeatherPage: onViewWillAppear");
 
-    // 只在UI未创建时创建，避免重复创建
-    if (!titleLabel) {
-        createWeatherUI();
-        // 显示默认数据，避免阻塞页面切换
-        displayDefaultWeatherInfo();
-    }
-
     // 延迟更新天气数据，避免阻塞菜单切换
     Serial.println("Weather: Scheduling weather update...");
     lastUpdateTime = millis() - UPDATE_INTERVAL + 2000; // 2秒后开始更新
@@ -72,6 +78,20 @@ void WeatherPage::onViewDidDisappear() {
     Serial.println("WeatherPage: onViewDidDisappear");
 }
 
+void WeatherPage::onViewUnload() {
+    Serial.println("WeatherPage: onViewUnload");
+    // Objects are deleted with _root; a fetch still running only updates
+    // the data, which onViewDidLoad shows after building the view again
+    titleLabel = nullptr;
+    weatherContainer = nullptr;
+    weatherIcon = nullptr;
+    temperatureLabel = nullptr;
+    descriptionLabel = nullptr;
+    cityLabel = nullptr;
+    humidityLabel = nullptr;
+    loadingSpinner = nullptr;
+}
+
 void WeatherPage::update() {
     // Check for automatic updates or initial update
     unsigned long currentTime = millis();
@@ -137,11 +157,26 @@ void WeatherPage::createWeatherUI() {
 
     // 删除instructionLabel，简化界面
 
-    // Loading spinner (initially hidden)
-    loadingSpinner = lv_spinner_create(_root, 1000, 60);
-    lv_obj_set_size(loadingSpinner, 40, 40);
-    lv_obj_align(loadingSpinner, LV_ALIGN_CENTER, 0, 0);
-    lv_obj_add_flag(loadingSpinner, LV_OBJ_FLAG_HIDDEN);
+    // The loading spinner is created by showLoadingIndicator() while a fetch runs
+}
+
+void WeatherPage::onKeyA(bool pressed) {
+    // Refresh
+    onButton(pressed);
+}
+
+void WeatherPage::onKeyB(bool pressed) {
+    (void)pressed;
+    Serial.println("Weather: Display mode switch not implemented yet");
+}
+
+void WeatherPage::onKeyC(bool pressed) {
+    (void)pressed;
+    Serial.println("Weather: Settings not implemented yet");
+}
+
+void WeatherPage::onTick() {
+    update();
 }
 
 void WeatherPage::onButton(bool pressed) {
@@ -186,13 +221,27 @@ void WeatherPage::updateWeatherData() {
     isUpdating = true;
     showLoadingIndicator(true);
 
+    // WiFi, HTTPS and parsing run on the network task; the spinner keeps
+    // animating and the result is shown from fetchDone() on the UI loop
+    if (!Tasks.submit(TASK_NET, fetchWork, fetchDone, this, "weather")) {
+        fetchDone(this, false);
+    }
+}
+
+bool WeatherPage::fetchWork(void* ctx) {
+    WeatherPage* page = static_cast<WeatherPage*>(ctx);
+
+    // Results go to pendingWeather, which only this task touches until
+    // fetchDone() copies it on the UI loop
+    page->pendingWeather.isValid = false;
+
     // Try to fetch real weather data
     bool success = false;
 
 #ifndef SIMULATOR_BUILD
     // Real hardware - try API first, fallback to mock data
-    if (weatherAPIKey != "your_seniverse_api_key_here" && weatherAPIKey.length() > 0) {
-        success = fetchWeatherFromAPI();
+    if (page->weatherAPIKey != "your_seniverse_api_key_here" && page->weatherAPIKey.length() > 0) {
+        success = page->fetchWeatherFromAPI();
         if (!success) {
             Serial.println("Weather: API failed, using mock data");
         }
@@ -201,26 +250,34 @@ void WeatherPage::updateWeatherData() {
     }
 #endif
 
-    // If API failed or simulator, use mock data
-    if (!success) {
-        currentWeather.city = "Beijing";
-        currentWeather.description = "Partly Cloudy";
-        currentWeather.temperature = 22;
-        currentWeather.humidity = 65;
-        currentWeather.updateTime = formatTime(millis());
-        currentWeather.isValid = true;
+    return success;
+}
+
+void WeatherPage::fetchDone(void* ctx, bool ok) {
+    WeatherPage* page = static_cast<WeatherPage*>(ctx);
+
+    if (ok) {
+        page->currentWeather = page->pendingWeather;
+    } else {
+        // API failed or simulator: use mock data
+        page->currentWeather.city = "Beijing";
+        page->currentWeather.description = "Partly Cloudy";
+        page->currentWeather.temperature = 22;
+        page->currentWeather.humidity = 65;
+        page->currentWeather.updateTime = page->formatTime(millis());
+        page->currentWeather.isValid = true;
     }
 
-    lastUpdateTime = millis();
-    isUpdating = false;
-    showLoadingIndicator(false);
+    page->lastUpdateTime = millis();
+    page->isUpdating = false;
+    page->showLoadingIndicator(false);
 
-    displayWeatherInfo();
+    page->displayWeatherInfo();
     Serial.println("Weather: Update completed");
 }
 
 void WeatherPage::displayWeatherInfo() {
-    if (!currentWeather.isValid) return;
+    if (!currentWeather.isValid || !weatherIcon) return;
 
     // Update weather icon
     WeatherIcon icon = getWeatherIcon(currentWeather.description);
@@ -253,10 +310,19 @@ void WeatherPage::refreshWeather() {
 }
 
 void WeatherPage::showLoadingIndicator(bool show) {
+    // A refresh may be requested (e.g. from the console) before the view exists
+    if (!_root) return;
+
+    // A hidden spinner keeps its animation running and would keep the frame
+    // governor awake, so it only exists while it is shown
     if (show) {
-        lv_obj_clear_flag(loadingSpinner, LV_OBJ_FLAG_HIDDEN);
-    } else {
-        lv_obj_add_flag(loadingSpinner, LV_OBJ_FLAG_HIDDEN);
+        if (loadingSpinner) return;
+        loadingSpinner = lv_spinner_create(_root, 1000, 60);
+        lv_obj_set_size(loadingSpinner, 40, 40);
+        lv_obj_align(loadingSpinner, LV_ALIGN_CENTER, 0, 0);
+    } else if (loadingSpinner) {
+        lv_obj_del(loadingSpinner);
+        loadingSpinner = nullptr;
     }
 }
 
@@ -368,8 +434,14 @@ bool WeatherPage::connectToWiFi() {
 
     // 快速检查：如果WiFiManager未初始化，快速失败避免阻塞
     if (!WiFiMgr.isInitialized()) {
+#if APP_USE_RTOS
+        // On the network task a slow first connect only delays the weather
+        Serial.println("Weather: Initializing WiFi on the network task...");
+        return WiFiMgr.begin() && WiFiMgr.isConnected();
+#else
         Serial.println("Weather: WiFiManager not initialized, skipping connection");
         return false;
+#endif
     }
 
     // 如果已经有凭据但未连接，尝试快速连接
@@ -461,38 +533,35 @@ bool WeatherPage::parseWeatherJSON(const String& json) {
             auto now = result["now"];
 
             // 提取基本天气数据（免费用户可用）
-            currentWeather.city = translateCityName(location["name"].as<String>());
-            currentWeather.temperature = now["temperature"].as<String>().toInt();
-            currentWeather.description = translateWeatherDescription(now["text"].as<String>());
+            pendingWeather.city = translateCityName(location["name"].as<String>());
+            pendingWeather.temperature = now["temperature"].as<String>().toInt();
+            pendingWeather.description = translateWeatherDescription(now["text"].as<String>());
 
             // 提取湿度数据（如果可用）
             if (now.containsKey("humidity")) {
-                currentWeather.humidity = now["humidity"].as<String>().toInt();
+                pendingWeather.humidity = now["humidity"].as<String>().toInt();
             } else {
-                currentWeather.humidity = 60;  // 默认湿度
+                pendingWeather.humidity = 60;  // 默认湿度
             }
 
-            currentWeather.updateTime = formatTime(millis());
-            currentWeather.isValid = true;
+            pendingWeather.updateTime = formatTime(millis());
+            pendingWeather.isValid = true;
 
             Serial.printf("Weather: 心知天气解析成功 - %s, %d°C, %s\n",
-                         currentWeather.city.c_str(),
-                         currentWeather.temperature,
-                         currentWeather.description.c_str());
+                         pendingWeather.city.c_str(),
+                         pendingWeather.temperature,
+                         pendingWeather.description.c_str());
             return true;
         }
     }
 #else
     // Simulator - parse mock data
-    currentWeather.city = "Beijing";
-    currentWeather.description = "Partly Cloudy";
-    currentWeather.temperature = 22;
-    currentWeather.humidity = 65;
-    currentWeather.pressure = 1013;
-    currentWeather.windDirection = "NW";
-    currentWeather.windSpeed = 12;
-    currentWeather.updateTime = formatTime(millis());
-    currentWeather.isValid = true;
+    pendingWeather.city = "Beijing";
+    pendingWeather.description = "Partly Cloudy";
+    pendingWeather.temperature = 22;
+    pendingWeather.humidity = 65;
+    pendingWeather.updateTime = formatTime(millis());
+    pendingWeather.isValid = true;
 
     Serial.println("Weather: Mock data parsed successfully");
     return true;
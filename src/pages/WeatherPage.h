@@ -2,6 +2,7 @@
 #define WEATHER_PAGE_H
 
 #include "../core/PageBase.h"
+#include "../core/TaskManager.h"
 #include <Arduino.h>
 
 // Weather data structure
@@ -32,13 +33,19 @@ public:
 
     // PageBase interface
     virtual void onViewLoad() override;
+    virtual void onViewDidLoad() override;
     virtual void onViewWillAppear() override;
     virtual void onViewDidAppear() override;
     virtual void onViewWillDisappear() override;
     virtual void onViewDidDisappear() override;
+    virtual void onViewUnload() override;
 
     // Button handlers (using PageBase interface)
     virtual void onButton(bool pressed) override;
+    virtual void onKeyA(bool pressed) override;
+    virtual void onKeyB(bool pressed) override;
+    virtual void onKeyC(bool pressed) override;
+    virtual void onTick() override;
     virtual void onKey(lv_dir_t direction) override;
 
     // Update method
@@ -64,7 +71,8 @@ private:
     lv_obj_t* loadingSpinner;
 
     // Weather data
-    WeatherData currentWeather;
+    WeatherData currentWeather;     // What the UI shows (UI loop only)
+    WeatherData pendingWeather;     // Filled by the network task
     unsigned long lastUpdateTime;
     bool isUpdating;
     
@@ -83,7 +91,9 @@ private:
     String translateWeatherDescription(const String& chineseDesc);
     String translateCityName(const String& chineseName);
     
-    // Network functions
+    // Network functions (run on the network task)
+    static bool fetchWork(void* ctx);
+    static void fetchDone(void* ctx, bool ok);
     bool connectToWiFi();
     String makeHTTPRequest(const String& url);
     bool parseWeatherJSON(const String& json);
@@ -0,0 +1,63 @@
+#include "BoundLabel.h"
+#include <stdarg.h>
+
+BoundLabelStats BoundLabel::stats = {};
+
+void BoundLabel::bind(lv_obj_t* label) {
+    obj = label;
+    text[0] = '\0';
+    textValid = false;
+    colorValid = false;
+}
+
+bool BoundLabel::setText(const char* newText) {
+    if (!obj || !newText) return false;
+
+    if (textValid && strcmp(text, newText) == 0) {
+        stats.textSkipped++;
+        return false;
+    }
+
+    size_t len = strlen(newText);
+    textValid = len < sizeof(text);
+    if (textValid) {
+        memcpy(text, newText, len + 1);
+    }
+
+    lv_label_set_text(obj, newText);
+    stats.textUpdates++;
+    return true;
+}
+
+bool BoundLabel::setTextFmt(const char* fmt, ...) {
+    // Labels are only updated from the UI loop, one at a time
+    static char buf[128];
+
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+
+    return setText(buf);
+}
+
+bool BoundLabel::setColor(lv_color_t newColor) {
+    if (!obj) return false;
+
+    if (colorValid && color.full == newColor.full) {
+        stats.colorSkipped++;
+        return false;
+    }
+
+    color = newColor;
+    colorValid = true;
+    lv_obj_set_style_text_color(obj, newColor, 0);
+    stats.colorUpdates++;
+    return true;
+}
+
+void BoundLabel::printStats() {
+    Serial.printf("BoundLabel: text %lu set / %lu skipped, color %lu set / %lu skipped\n",
+                  (unsigned long)stats.textUpdates, (unsigned long)stats.textSkipped,
+                  (unsigned long)stats.colorUpdates, (unsigned long)stats.colorSkipped);
+}
@@ -0,0 +1,50 @@
+#ifndef BOUND_LABEL_H
+#define BOUND_LABEL_H
+
+#include <Arduino.h>
+#include "lvgl.h"
+
+// Longest text kept for comparison; longer texts are always written through
+#define BOUND_LABEL_TEXT_LEN 32
+
+// Update counters shared by all bound labels
+struct BoundLabelStats {
+    uint32_t textUpdates;     // Texts written to LVGL
+    uint32_t textSkipped;     // Texts equal to what the label already showed
+    uint32_t colorUpdates;
+    uint32_t colorSkipped;
+};
+
+// Wraps an lv_label and only touches LVGL when the shown value really
+// changes, so periodic refreshes don't re-layout and invalidate the label.
+// Values are formatted into a fixed buffer and compared with the last one.
+class BoundLabel {
+public:
+    BoundLabel() = default;
+
+    // Attach to a (new) label; forgets the cached value
+    void bind(lv_obj_t* label);
+    void unbind() { bind(nullptr); }
+    lv_obj_t* get() const { return obj; }
+
+    // Return true if the label was changed
+    bool setText(const char* text);
+    bool setTextFmt(const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+    bool setColor(lv_color_t color);
+
+    // Statistics
+    static const BoundLabelStats& getStats() { return stats; }
+    static void resetStats() { stats = {}; }
+    static void printStats();
+
+private:
+    lv_obj_t* obj = nullptr;
+    char text[BOUND_LABEL_TEXT_LEN] = {};
+    bool textValid = false;
+    bool colorValid = false;
+    lv_color_t color = {};
+
+    static BoundLabelStats stats;
+};
+
+#endif // BOUND_LABEL_H
@@ -0,0 +1,73 @@
+#include "CachedLayer.h"
+
+#if DISP_CHROME_CACHE
+
+#if !LV_USE_SNAPSHOT
+#error "DISP_CHROME_CACHE needs LV_USE_SNAPSHOT=1 in build_flags"
+#endif
+
+CachedLayer::~CachedLayer() {
+    if (image) lv_obj_del(image);
+    if (buf) free(buf);
+}
+
+bool CachedLayer::attach(lv_obj_t* obj) {
+    if (image || !obj) return false;
+
+    lv_obj_update_layout(obj);
+    bufSize = lv_snapshot_buf_size_needed(obj, LV_IMG_CF_TRUE_COLOR);
+    buf = (uint8_t*)malloc(bufSize);
+    if (!buf) {
+        Serial.printf("CachedLayer: Cannot allocate %lu bytes\n", (unsigned long)bufSize);
+        bufSize = 0;
+        return false;
+    }
+    source = obj;
+
+    // The snapshot includes the extra draw area (shadows, outlines) around the object
+    lv_coord_t ext = _lv_obj_get_ext_draw_size(source);
+    image = lv_img_create(lv_obj_get_parent(source));
+    lv_obj_set_pos(image, lv_obj_get_x(source) - ext, lv_obj_get_y(source) - ext);
+    lv_obj_clear_flag(image, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_move_to_index(image, lv_obj_get_index(source) + 1);
+
+    update();
+    lv_img_set_src(image, &dsc);
+    lv_obj_add_flag(source, LV_OBJ_FLAG_HIDDEN);
+
+    Serial.printf("CachedLayer: Cached %dx%d layer (%lu bytes)\n",
+                  (int)dsc.header.w, (int)dsc.header.h, (unsigned long)bufSize);
+    return true;
+}
+
+void CachedLayer::update() {
+    if (!source || live) return;
+
+    // Rendered even while the source is hidden
+    lv_obj_update_layout(source);
+    if (lv_snapshot_take_to_buf(source, LV_IMG_CF_TRUE_COLOR, &dsc, buf, bufSize) != LV_RES_OK) {
+        Serial.println("CachedLayer: Snapshot failed, showing live layer");
+        setLive(true);
+        return;
+    }
+    snapshots++;
+
+    lv_img_cache_invalidate_src(&dsc);
+    lv_obj_invalidate(image);
+}
+
+void CachedLayer::setLive(bool enabled) {
+    if (!image || enabled == live) return;
+    live = enabled;
+
+    if (live) {
+        lv_obj_clear_flag(source, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_add_flag(image, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        update();
+        lv_obj_add_flag(source, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_clear_flag(image, LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
+#endif // DISP_CHROME_CACHE
@@ -0,0 +1,46 @@
+#ifndef CACHED_LAYER_H
+#define CACHED_LAYER_H
+
+#include <Arduino.h>
+#include "lvgl.h"
+#include "../config/display_config.h"
+
+// Shows a static widget tree as one pre-rendered image. The source object
+// stays hidden and is only rasterized again when update() is called, so
+// invalidations around it cost a blit instead of a full widget redraw.
+// While the content is animating, setLive(true) shows the source directly.
+// Note: the image does not forward input events to the hidden source.
+class CachedLayer {
+public:
+    CachedLayer() = default;
+    ~CachedLayer();
+
+    // Take over source (allocates the snapshot buffer on the heap)
+    bool attach(lv_obj_t* source);
+
+    // Source content changed - render it into the cache again
+    void update();
+
+    // Show the live source instead of the cache; leaving live mode re-snapshots
+    void setLive(bool enabled);
+
+    // Status
+    bool isAttached() const { return image != nullptr; }
+    bool isLive() const { return live; }
+    uint32_t getBufferSize() const { return bufSize; }
+    uint32_t getSnapshotCount() const { return snapshots; }
+
+private:
+    CachedLayer(const CachedLayer&) = delete;
+    CachedLayer& operator=(const CachedLayer&) = delete;
+
+    lv_obj_t* source = nullptr;
+    lv_obj_t* image = nullptr;
+    lv_img_dsc_t dsc = {};
+    uint8_t* buf = nullptr;
+    uint32_t bufSize = 0;
+    bool live = false;
+    uint32_t snapshots = 0;
+};
+
+#endif // CACHED_LAYER_H
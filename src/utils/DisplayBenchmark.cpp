@@ -0,0 +1,198 @@
+#include "DisplayBenchmark.h"
+#include "DisplayManager.h"
+#include "../core/AppManager.h"
+
+#define BENCH_PAGE_SWITCHES     8       // Alternating right/left between the first two pages
+#define BENCH_ANIM_MS           250     // Transition length when none is configured
+#define BENCH_NAV_STEPS         7
+#define BENCH_SPINNER_MS        3000
+#define BENCH_TEXT_FRAMES       30
+#define BENCH_SETTLE_MS         1500
+
+DisplayBenchmark& DisplayBenchmark::getInstance() {
+    static DisplayBenchmark instance;
+    return instance;
+}
+
+void DisplayBenchmark::run(AppManager* app) {
+    Serial.printf("DisplayBenchmark: strategy %s, %lu bytes of draw buffers, DMA %s\n",
+                  DisplayMgr.getBufferStrategyName(),
+                  (unsigned long)DisplayMgr.getDrawBufferBytes(),
+                  DisplayMgr.isDMAEnabled() ? "on" : "off");
+
+    // Measure at the fastest rate the governor would allow
+    DisplayMgr.setRefreshPeriod(DISP_ACTIVE_REFR_PERIOD);
+    settle(BENCH_SETTLE_MS);
+
+    if (app) scenePageSwitch(app);
+    sceneNavAnimation();
+    sceneSpinner();
+    sceneFullScreenText();
+
+    Serial.println("DisplayBenchmark: done");
+}
+
+void DisplayBenchmark::scenePageSwitch(AppManager* app) {
+    // Instant switch first, then each kind of transition at the configured length
+    static const struct {
+        PageManager::LoadAnim_t type;
+        const char* name;
+    } anims[] = {
+        {PageManager::LOAD_ANIM_NONE,      "page switch"},
+        {PageManager::LOAD_ANIM_OVER_LEFT, "page anim over"},
+        {PageManager::LOAD_ANIM_MOVE_LEFT, "page anim move"},
+        {PageManager::LOAD_ANIM_FADE_ON,   "page anim fade"},
+    };
+
+    PageManager* pages = app->getPageManager();
+    PageManager::LoadAnim_t savedType = pages->GetGlobalLoadAnimType();
+    uint16_t time = pages->GetGlobalLoadAnimTime() ? pages->GetGlobalLoadAnimTime() : BENCH_ANIM_MS;
+
+    for (const auto& anim : anims) {
+        pages->SetGlobalLoadAnimType(anim.type, time);
+        beginScene(anim.name);
+        for (int i = 0; i < BENCH_PAGE_SWITCHES; i++) {
+            app->handleInput((i & 1) ? LV_DIR_LEFT : LV_DIR_RIGHT);
+            settle(BENCH_SETTLE_MS);
+        }
+        endScene();
+    }
+
+    pages->SetGlobalLoadAnimType(savedType, time);
+}
+
+void DisplayBenchmark::sceneNavAnimation() {
+    // Same size, travel and easing as the navigation bar indicator
+    lv_obj_t* indicator = lv_obj_create(lv_layer_top());
+    lv_obj_remove_style_all(indicator);
+    lv_obj_set_size(indicator, 45, 4);
+    lv_obj_set_pos(indicator, 2, 62);
+    lv_obj_set_style_bg_color(indicator, lv_color_hex(0x00D4FF), 0);
+    lv_obj_set_style_bg_opa(indicator, LV_OPA_COVER, 0);
+    settle(BENCH_SETTLE_MS);
+
+    beginScene("nav animation");
+    // Slide to the last slot one page at a time and back again
+    for (int i = 1; i < BENCH_NAV_STEPS * 2 - 1; i++) {
+        int index = (i < BENCH_NAV_STEPS) ? i : (BENCH_NAV_STEPS - 1) * 2 - i;
+
+        lv_anim_t a;
+        lv_anim_init(&a);
+        lv_anim_set_var(&a, indicator);
+        lv_anim_set_values(&a, lv_obj_get_x(indicator), index * 46 + 2);
+        lv_anim_set_time(&a, 200);
+        lv_anim_set_exec_cb(&a, (lv_anim_exec_xcb_t)lv_obj_set_x);
+        lv_anim_set_path_cb(&a, lv_anim_path_ease_out);
+        lv_anim_start(&a);
+        settle(BENCH_SETTLE_MS);
+    }
+    endScene();
+
+    lv_obj_del(indicator);
+    settle(BENCH_SETTLE_MS);
+}
+
+void DisplayBenchmark::sceneSpinner() {
+    lv_obj_t* spinner = lv_spinner_create(lv_layer_top(), 1000, 60);
+    lv_obj_set_size(spinner, 50, 50);
+    lv_obj_center(spinner);
+    settle(100);
+
+    beginScene("spinner");
+    runFor(BENCH_SPINNER_MS);
+    endScene();
+
+    lv_obj_del(spinner);
+    settle(BENCH_SETTLE_MS);
+}
+
+void DisplayBenchmark::sceneFullScreenText() {
+    lv_obj_t* panel = lv_obj_create(lv_layer_top());
+    lv_obj_set_size(panel, DISP_HOR_RES, DISP_VER_RES);
+    lv_obj_set_pos(panel, 0, 0);
+    lv_obj_set_style_bg_color(panel, lv_color_hex(0x000000), 0);
+    lv_obj_set_style_bg_opa(panel, LV_OPA_COVER, 0);
+    lv_obj_set_style_border_width(panel, 0, 0);
+    lv_obj_set_style_radius(panel, 0, 0);
+    lv_obj_clear_flag(panel, LV_OBJ_FLAG_SCROLLABLE);
+
+    lv_obj_t* label = lv_label_create(panel);
+    lv_obj_set_width(label, DISP_HOR_RES - 20);
+    lv_obj_set_style_text_color(label, lv_color_white(), 0);
+    lv_label_set_long_mode(label, LV_LABEL_LONG_WRAP);
+    settle(BENCH_SETTLE_MS);
+
+    // Every frame changes the whole text block, so every frame is a full redraw
+    static char text[512];
+    beginScene("full-screen text");
+    for (int frame = 0; frame < BENCH_TEXT_FRAMES; frame++) {
+        int len = 0;
+        for (int line = 0; line < 12 && len < (int)sizeof(text) - 40; line++) {
+            len += snprintf(text + len, sizeof(text) - len,
+                            "Frame %02d line %02d  0123456789 ABCDEF\n", frame, line);
+        }
+        lv_label_set_text(label, text);
+        lv_obj_invalidate(panel);
+        settle(BENCH_SETTLE_MS);
+    }
+    endScene();
+
+    lv_obj_del(panel);
+    settle(BENCH_SETTLE_MS);
+}
+
+void DisplayBenchmark::settle(uint32_t timeoutMs) {
+    uint32_t start = millis();
+    lv_disp_t* disp = DisplayMgr.getDisplay();
+    do {
+        step();
+    } while ((lv_anim_count_running() > 0 || (disp && disp->inv_p > 0)) &&
+             millis() - start < timeoutMs);
+}
+
+void DisplayBenchmark::runFor(uint32_t durationMs) {
+    uint32_t start = millis();
+    while (millis() - start < durationMs) {
+        step();
+    }
+}
+
+void DisplayBenchmark::step() {
+    uint32_t flushedBefore = DisplayMgr.getRefreshStats().flushedPasses;
+    uint32_t startUs = micros();
+    DisplayMgr.update();
+    uint32_t frameUs = micros() - startUs;
+
+    if (DisplayMgr.getRefreshStats().flushedPasses != flushedBefore) {
+        current.frames++;
+        totalFrameUs += frameUs;
+        if (frameUs > current.maxFrameUs) current.maxFrameUs = frameUs;
+    }
+    delay(1);
+}
+
+void DisplayBenchmark::beginScene(const char* name) {
+    current = {};
+    current.name = name;
+    totalFrameUs = 0;
+    sceneStartMs = millis();
+    scenePixelsStart = DisplayMgr.getRefreshStats().pixels;
+}
+
+void DisplayBenchmark::endScene() {
+    current.elapsedMs = millis() - sceneStartMs;
+    current.pixels = DisplayMgr.getRefreshStats().pixels - scenePixelsStart;
+    current.avgFrameUs = current.frames ? (uint32_t)(totalFrameUs / current.frames) : 0;
+    printResult(current);
+}
+
+void DisplayBenchmark::printResult(const BenchmarkResult& result) {
+    uint32_t fps10 = result.elapsedMs ? result.frames * 10000 / result.elapsedMs : 0;
+    Serial.printf("DisplayBenchmark: %-16s %4lu frames, avg %6lu us, max %6lu us, %lu.%lu FPS, %lu px\n",
+                  result.name,
+                  (unsigned long)result.frames,
+                  (unsigned long)result.avgFrameUs,
+                  (unsigned long)result.maxFrameUs,
+                  (unsigned long)(fps10 / 10), (unsigned long)(fps10 % 10),
+                  (unsigned long)result.pixels);
+}
@@ -0,0 +1,62 @@
+#ifndef DISPLAY_BENCHMARK_H
+#define DISPLAY_BENCHMARK_H
+
+#include <Arduino.h>
+#include "lvgl.h"
+#include "../config/display_config.h"
+
+class AppManager;
+
+// Result of one benchmark scene
+struct BenchmarkResult {
+    const char* name;
+    uint32_t frames;        // Refresh passes that pushed pixels
+    uint32_t avgFrameUs;    // Render + flush time per frame
+    uint32_t maxFrameUs;
+    uint32_t elapsedMs;     // Wall time of the scene
+    uint32_t pixels;        // Pixels pushed to the panel
+};
+
+// Runs a fixed set of scenes (page switch with each transition type, nav
+// animation, spinner, full-screen text) against the compiled draw-buffer strategy and prints
+// frame times together with the draw buffer RAM cost. Rebuild with each
+// DISP_BUF_STRATEGY to compare them.
+class DisplayBenchmark {
+public:
+    static DisplayBenchmark& getInstance();
+
+    void run(AppManager* app);
+
+private:
+    DisplayBenchmark() = default;
+    ~DisplayBenchmark() = default;
+    DisplayBenchmark(const DisplayBenchmark&) = delete;
+    DisplayBenchmark& operator=(const DisplayBenchmark&) = delete;
+
+    // Scenes
+    void scenePageSwitch(AppManager* app);
+    void sceneNavAnimation();
+    void sceneSpinner();
+    void sceneFullScreenText();
+
+    // Drive the display until animations have ended and nothing is left
+    // to redraw, or timeoutMs passed
+    void settle(uint32_t timeoutMs);
+    // Drive the display for a fixed time
+    void runFor(uint32_t durationMs);
+    void step();
+
+    void beginScene(const char* name);
+    void endScene();
+    void printResult(const BenchmarkResult& result);
+
+    BenchmarkResult current = {};
+    uint64_t totalFrameUs = 0;
+    uint32_t sceneStartMs = 0;
+    uint32_t scenePixelsStart = 0;
+};
+
+// Global instance access
+#define DisplayBench DisplayBenchmark::getInstance()
+
+#endif // DISPLAY_BENCHMARK_H
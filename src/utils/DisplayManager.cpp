@@ -0,0 +1,351 @@
+#include "DisplayManager.h"
+#include "FrameProfiler.h"
+#include "LatencyTracker.h"
+#include "color_utils.h"
+
+#include <string.h>
+
+#include <TFT_eSPI.h>
+
+static TFT_eSPI tft = TFT_eSPI();
+
+// The panel takes RGB565 MSB first. With LV_COLOR_16_SWAP LVGL already renders
+// in that order and buffers are sent as they are; otherwise each flushed area
+// is swapped once, in place, before anything else looks at it.
+#if !LV_COLOR_16_SWAP
+#define DISP_FLUSH_SWAP 1
+#else
+#define DISP_FLUSH_SWAP 0
+#endif
+
+static lv_disp_draw_buf_t draw_buf;
+static lv_disp_drv_t disp_drv;
+
+// With two buffers LVGL renders into one while the other is sent over SPI
+#if DISP_BUF_COUNT > 1 && DISP_USE_DMA
+#define DISP_HAS_BUF2 1
+#else
+#define DISP_HAS_BUF2 0
+#endif
+
+static lv_color_t buf1[DISP_HOR_RES * DISP_BUF_LINES];
+#if DISP_HAS_BUF2
+static lv_color_t buf2[DISP_HOR_RES * DISP_BUF_LINES];
+#endif
+
+static const char* const strategyNames[] = {
+    "single-small", "double-small", "double-large"
+};
+
+DisplayManager& DisplayManager::getInstance() {
+    static DisplayManager instance;
+    return instance;
+}
+
+bool DisplayManager::begin() {
+    if (disp) return true;
+
+    Serial.println("DisplayManager: Initializing TFT...");
+    tft.begin();
+    tft.setRotation(3);
+    tft.fillScreen(TFT_BLACK);
+
+#if DISP_USE_DMA
+    dmaEnabled = tft.initDMA();
+    Serial.printf("DisplayManager: DMA %s\n", dmaEnabled ? "enabled" : "not available, using blocking flush");
+#endif
+
+    lv_init();
+
+#if DISP_ROW_HASH
+    // Nothing matches until the first frame has been sent
+    memset(rowHashes, 0xFF, sizeof(rowHashes));
+#endif
+
+    // A second buffer only helps when the flush returns before the transfer ends
+    lv_color_t* second = nullptr;
+#if DISP_HAS_BUF2
+    if (dmaEnabled) second = buf2;
+#endif
+    lv_disp_draw_buf_init(&draw_buf, buf1, second, DISP_HOR_RES * DISP_BUF_LINES);
+    Serial.printf("DisplayManager: %s draw buffer, %d x %d lines (%lu bytes)\n",
+                  getBufferStrategyName(), second ? 2 : 1, DISP_BUF_LINES,
+                  (unsigned long)getDrawBufferBytes());
+
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res = DISP_HOR_RES;
+    disp_drv.ver_res = DISP_VER_RES;
+    disp_drv.flush_cb = flushCallback;
+    disp_drv.wait_cb = waitCallback;
+    disp_drv.draw_buf = &draw_buf;
+    disp = lv_disp_drv_register(&disp_drv);
+    if (!disp) return false;
+
+    // Route the refresh timer through us so every pass can be counted
+    refreshTimer = _lv_disp_get_refr_timer(disp);
+    lv_timer_set_cb(refreshTimer, refreshTimerCallback);
+    lastTick = millis();
+
+    Serial.println("DisplayManager: LVGL display driver registered");
+    return true;
+}
+
+uint32_t DisplayManager::update() {
+    // LVGL has no tick source of its own in this build
+    uint32_t now = millis();
+    lv_tick_inc(now - lastTick);
+    lastTick = now;
+
+    poll();
+
+#if DISP_FORCE_REFRESH_MS > 0
+    if (now - lastForcedRefresh >= DISP_FORCE_REFRESH_MS) {
+        lv_timer_ready(refreshTimer);
+        lastForcedRefresh = now;
+    }
+#endif
+
+    return lv_timer_handler();
+}
+
+void DisplayManager::setRefreshPeriod(uint32_t period) {
+    if (refreshTimer) {
+        lv_timer_set_period(refreshTimer, period);
+    }
+}
+
+const char* DisplayManager::getBufferStrategyName() const {
+    return strategyNames[DISP_BUF_STRATEGY];
+}
+
+uint32_t DisplayManager::getDrawBufferBytes() const {
+#if DISP_HAS_BUF2
+    return sizeof(buf1) + sizeof(buf2);
+#else
+    return sizeof(buf1);
+#endif
+}
+
+void DisplayManager::resetRefreshStats() {
+    stats = {};
+}
+
+void DisplayManager::printRefreshStats() {
+    Serial.printf("Display: %lu refresh passes, %lu with flushed pixels (%lu px total, %lu px skipped unchanged)\n",
+                  (unsigned long)stats.passes,
+                  (unsigned long)stats.flushedPasses,
+                  (unsigned long)stats.pixels,
+                  (unsigned long)stats.skippedPixels);
+    if (dmaEnabled) {
+        Serial.printf("Display: %lu flushes by DMA, %lu as blocking spans (DMA bypassed)\n",
+                      (unsigned long)stats.dmaFlushes,
+                      (unsigned long)stats.spanFlushes);
+    }
+}
+
+void DisplayManager::refreshTimerCallback(lv_timer_t* timer) {
+    DisplayManager& self = getInstance();
+    uint32_t pixelsBefore = self.stats.pixels;
+#if DISP_PROFILER
+    FrameProf.beginFrame(self.disp->inv_p);
+#endif
+
+    _lv_disp_refr_timer(timer);
+
+#if DISP_PROFILER
+    FrameProf.endFrame(self.stats.pixels - pixelsBefore);
+#endif
+
+    self.stats.passes++;
+#if DISP_LATENCY_TRACKER
+    LatencyTrk.onRefreshPass(self.stats.pixels != pixelsBefore);
+#endif
+    if (self.stats.pixels != pixelsBefore) {
+        self.stats.flushedPasses++;
+    }
+}
+
+void DisplayManager::poll() {
+    if (pendingFlush && !tft.dmaBusy()) {
+        onTransferComplete();
+    }
+}
+
+void DisplayManager::flushCallback(lv_disp_drv_t* drv, const lv_area_t* area, lv_color_t* color_p) {
+    DisplayManager& self = getInstance();
+    uint32_t w = (area->x2 - area->x1 + 1);
+    uint32_t h = (area->y2 - area->y1 + 1);
+    const uint16_t* pixels = (const uint16_t*)&color_p->full;
+#if DISP_PROFILER
+    uint32_t flushStartUs = micros();
+#endif
+#if DISP_LATENCY_TRACKER
+    LatencyTrk.onFlush();
+#endif
+
+#if DISP_FLUSH_SWAP
+    rgb565_swap_buf((uint16_t*)pixels, pixels, w * h);
+#endif
+
+#if DISP_ROW_HASH
+    // Drop the rows/blocks whose pixels the panel already shows
+    uint32_t changedBlocks = self.markChangedBlocks(area, pixels);
+    uint32_t totalBlocks = self.countBlocks(area) * h;
+    uint32_t skippedBlocks = totalBlocks - changedBlocks;
+    bool worthSkipping = skippedBlocks > 0 &&
+        (!self.dmaEnabled || skippedBlocks * 100 >= totalBlocks * DISP_HASH_MIN_SKIP_PCT);
+    if (worthSkipping) {
+        if (self.dmaEnabled) self.stats.spanFlushes++;
+        self.pushChangedSpans(area, pixels);
+#if DISP_PROFILER
+        FrameProf.addFlushTime(micros() - flushStartUs);
+#endif
+        lv_disp_flush_ready(drv);
+        return;
+    }
+#endif
+
+    if (self.dmaEnabled) {
+        // LVGL never hands over a new buffer before flush_ready, so the bus is free here
+        self.stats.pixels += w * h;
+        self.stats.dmaFlushes++;
+        tft.startWrite();
+        tft.setAddrWindow(area->x1, area->y1, w, h);
+        tft.setSwapBytes(false);
+        self.pendingFlush = drv;
+        tft.pushPixelsDMA((uint16_t*)pixels, w * h);
+#if DISP_PROFILER
+        FrameProf.addFlushTime(micros() - flushStartUs);
+#endif
+        return; // flush_ready is signalled from onTransferComplete()
+    }
+
+    self.writeRect(area, pixels, w);
+
+#if DISP_PROFILER
+    FrameProf.addFlushTime(micros() - flushStartUs);
+#endif
+    lv_disp_flush_ready(drv);
+}
+
+void DisplayManager::writeRect(const lv_area_t* rect, const uint16_t* src, uint32_t stride) {
+    uint32_t w = rect->x2 - rect->x1 + 1;
+    uint32_t h = rect->y2 - rect->y1 + 1;
+    stats.pixels += w * h;
+
+    tft.startWrite();
+    tft.setAddrWindow(rect->x1, rect->y1, w, h);
+    if (stride == w) {
+        tft.pushColors((uint16_t*)src, w * h, false);
+    } else {
+        // Rows of a sub-rectangle are not contiguous in the draw buffer
+        for (uint32_t row = 0; row < h; row++) {
+            tft.pushColors((uint16_t*)src + row * stride, w, false);
+        }
+    }
+    tft.endWrite();
+}
+
+#if DISP_ROW_HASH
+// Hash of one row span; the span position is part of the seed so that
+// spans of different width in the same block never compare equal.
+static uint32_t hashSpan(const uint16_t* px, int32_t x1, int32_t x2) {
+    uint32_t hash = 2166136261u ^ ((uint32_t)x1 << 16 | (uint32_t)x2);
+    for (int32_t x = x1; x <= x2; x++) {
+        hash = (hash ^ *px++) * 16777619u;
+    }
+    return hash;
+}
+
+uint32_t DisplayManager::countBlocks(const lv_area_t* area) const {
+    return area->x2 / DISP_HASH_BLOCK_W - area->x1 / DISP_HASH_BLOCK_W + 1;
+}
+
+uint32_t DisplayManager::markChangedBlocks(const lv_area_t* area, const uint16_t* pixels) {
+    uint32_t w = area->x2 - area->x1 + 1;
+    int32_t firstBlock = area->x1 / DISP_HASH_BLOCK_W;
+    int32_t lastBlock = area->x2 / DISP_HASH_BLOCK_W;
+    uint32_t changed = 0;
+
+    for (int32_t y = area->y1; y <= area->y2; y++) {
+        const uint16_t* row = pixels + (y - area->y1) * w;
+        uint32_t mask = 0;
+
+        for (int32_t b = firstBlock; b <= lastBlock; b++) {
+            int32_t sx = b * DISP_HASH_BLOCK_W;
+            int32_t ex = sx + DISP_HASH_BLOCK_W - 1;
+            if (sx < area->x1) sx = area->x1;
+            if (ex > area->x2) ex = area->x2;
+
+            uint32_t hash = hashSpan(row + (sx - area->x1), sx, ex);
+            uint32_t& stored = rowHashes[y][b];
+            if (stored != hash) {
+                stored = hash;
+                mask |= 1UL << (b - firstBlock);
+                changed++;
+            }
+        }
+        changedMask[y] = mask;
+    }
+
+    return changed;
+}
+
+void DisplayManager::pushChangedSpans(const lv_area_t* area, const uint16_t* pixels) {
+    uint32_t w = area->x2 - area->x1 + 1;
+    int32_t firstBlock = area->x1 / DISP_HASH_BLOCK_W;
+    uint32_t blocks = countBlocks(area);
+    int32_t y = area->y1;
+
+    while (y <= area->y2) {
+        // Rows with the same change mask share one address window per span
+        uint32_t mask = changedMask[y];
+        int32_t yEnd = y;
+        while (yEnd < area->y2 && changedMask[yEnd + 1] == mask) yEnd++;
+        uint32_t rows = yEnd - y + 1;
+
+        uint32_t b = 0;
+        while (b < blocks) {
+            uint32_t runStart = b;
+            bool changed = mask & (1UL << b);
+            while (b < blocks && ((mask & (1UL << b)) != 0) == changed) b++;
+
+            lv_area_t rect;
+            rect.x1 = (firstBlock + runStart) * DISP_HASH_BLOCK_W;
+            rect.x2 = (firstBlock + b) * DISP_HASH_BLOCK_W - 1;
+            if (rect.x1 < area->x1) rect.x1 = area->x1;
+            if (rect.x2 > area->x2) rect.x2 = area->x2;
+
+            if (changed) {
+                rect.y1 = y;
+                rect.y2 = yEnd;
+                writeRect(&rect, pixels + (y - area->y1) * w + (rect.x1 - area->x1), w);
+            } else {
+                stats.skippedPixels += (rect.x2 - rect.x1 + 1) * rows;
+            }
+        }
+
+        y = yEnd + 1;
+    }
+}
+#endif
+
+void DisplayManager::waitCallback(lv_disp_drv_t* drv) {
+    (void)drv;
+    // Called by LVGL while it waits for the other buffer to be released
+#if DISP_PROFILER
+    uint32_t waitStartUs = micros();
+    getInstance().poll();
+    FrameProf.addFlushTime(micros() - waitStartUs);
+#else
+    getInstance().poll();
+#endif
+}
+
+void DisplayManager::onTransferComplete() {
+    lv_disp_drv_t* drv = pendingFlush;
+    pendingFlush = nullptr;
+
+    tft.endWrite();
+    lv_disp_flush_ready(drv);
+}
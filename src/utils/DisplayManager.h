@@ -0,0 +1,80 @@
+#ifndef DISPLAY_MANAGER_H
+#define DISPLAY_MANAGER_H
+
+#include <Arduino.h>
+#include "lvgl.h"
+#include "../config/display_config.h"
+
+// Refresh pass counters
+struct RefreshStats {
+    uint32_t passes;          // Refresh timer runs
+    uint32_t flushedPasses;   // Runs that actually pushed pixels
+    uint32_t pixels;          // Total pixels pushed
+    uint32_t skippedPixels;   // Pixels dropped because the panel already showed them
+    uint32_t spanFlushes;     // Flushes sent as changed spans (blocking, DMA bypassed)
+    uint32_t dmaFlushes;      // Flushes sent with one DMA transfer
+};
+
+class DisplayManager {
+public:
+    static DisplayManager& getInstance();
+
+    // Initialize the TFT and register the LVGL display driver
+    bool begin();
+
+    // Advance the LVGL tick and run its timers; refreshes happen only
+    // when something was invalidated. Returns ms until the next LVGL timer.
+    uint32_t update();
+
+    // Complete a finished DMA transfer
+    void poll();
+
+    // Status
+    bool isDMAEnabled() const { return dmaEnabled; }
+    lv_disp_t* getDisplay() const { return disp; }
+    const RefreshStats& getRefreshStats() const { return stats; }
+    void setRefreshPeriod(uint32_t period);
+    const char* getBufferStrategyName() const;
+    uint32_t getDrawBufferBytes() const;       // Statically allocated draw buffers
+    void resetRefreshStats();
+    void printRefreshStats();
+
+private:
+    DisplayManager() = default;
+    ~DisplayManager() = default;
+    DisplayManager(const DisplayManager&) = delete;
+    DisplayManager& operator=(const DisplayManager&) = delete;
+
+    // LVGL driver callbacks
+    static void flushCallback(lv_disp_drv_t* drv, const lv_area_t* area, lv_color_t* color_p);
+    static void waitCallback(lv_disp_drv_t* drv);
+    static void refreshTimerCallback(lv_timer_t* timer);
+
+    void onTransferComplete();
+    void writeRect(const lv_area_t* rect, const uint16_t* src, uint32_t stride);
+#if DISP_ROW_HASH
+    uint32_t countBlocks(const lv_area_t* area) const;
+    uint32_t markChangedBlocks(const lv_area_t* area, const uint16_t* pixels);
+    void pushChangedSpans(const lv_area_t* area, const uint16_t* pixels);
+#endif
+
+    lv_disp_t* disp = nullptr;
+    bool dmaEnabled = false;
+    lv_disp_drv_t* volatile pendingFlush = nullptr; // Driver waiting for the running DMA transfer
+
+    lv_timer_t* refreshTimer = nullptr;
+    uint32_t lastTick = 0;
+    uint32_t lastForcedRefresh = 0;
+    RefreshStats stats = {};
+
+#if DISP_ROW_HASH
+    // Last hash sent for each row span of every DISP_HASH_BLOCK_W wide column block
+    uint32_t rowHashes[DISP_VER_RES][DISP_HASH_BLOCKS];
+    uint32_t changedMask[DISP_VER_RES];   // Changed blocks of each row in the current area
+#endif
+};
+
+// Global instance access
+#define DisplayMgr DisplayManager::getInstance()
+
+#endif // DISPLAY_MANAGER_H
@@ -0,0 +1,59 @@
+#include "FrameGovernor.h"
+#include "lvgl.h"
+#include "DisplayManager.h"
+
+FrameGovernor& FrameGovernor::getInstance() {
+    static FrameGovernor instance;
+    return instance;
+}
+
+void FrameGovernor::update() {
+    unsigned long now = millis();
+
+    // An animation only counts while it is actually producing pixels;
+    // e.g. the weather spinner keeps running while hidden.
+    uint32_t flushedPasses = DisplayMgr.getRefreshStats().flushedPasses;
+    if (lv_anim_count_running() > 0 && flushedPasses != lastFlushedPasses) {
+        lastActivity = now;
+    }
+    lastFlushedPasses = flushedPasses;
+
+    bool wantActive = (now - lastActivity) < DISP_ACTIVE_HOLD_MS;
+    if (!applied || wantActive != active) {
+        setActive(wantActive, now);
+    }
+}
+
+void FrameGovernor::kick() {
+    unsigned long now = millis();
+    lastActivity = now;
+    if (!active) {
+        setActive(true, now);
+    }
+}
+
+void FrameGovernor::setActive(bool newActive, unsigned long now) {
+    if (applied) {
+        if (active) {
+            activeTime += now - modeSince;
+        } else {
+            idleTime += now - modeSince;
+        }
+        switches++;
+    }
+
+    active = newActive;
+    applied = true;
+    modeSince = now;
+    DisplayMgr.setRefreshPeriod(active ? DISP_ACTIVE_REFR_PERIOD : DISP_IDLE_REFR_PERIOD);
+}
+
+void FrameGovernor::printStats() {
+    unsigned long now = millis();
+    unsigned long activeTotal = activeTime + (active ? now - modeSince : 0);
+    unsigned long idleTotal = idleTime + (active ? 0 : now - modeSince);
+
+    Serial.printf("FrameGovernor: %s, active %lus, idle %lus, %lu switches\n",
+                  active ? "ACTIVE" : "IDLE",
+                  activeTotal / 1000, idleTotal / 1000, (unsigned long)switches);
+}
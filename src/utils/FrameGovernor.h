@@ -0,0 +1,47 @@
+#ifndef FRAME_GOVERNOR_H
+#define FRAME_GOVERNOR_H
+
+#include <Arduino.h>
+#include "../config/display_config.h"
+
+// Switches the LVGL refresh period and the loop sleep between a fast rate
+// (animations running, recent input) and a slow rate (static screen).
+class FrameGovernor {
+public:
+    static FrameGovernor& getInstance();
+
+    // Re-evaluate the rate (call once per loop, after DisplayManager::update)
+    void update();
+
+    // Report user activity, e.g. an input event; switches to the fast rate at once
+    void kick();
+
+    // Status
+    bool isActive() const { return active; }
+    uint32_t getLoopDelay() const { return active ? LOOP_ACTIVE_DELAY_MS : LOOP_IDLE_DELAY_MS; }
+    void printStats();
+
+private:
+    FrameGovernor() = default;
+    ~FrameGovernor() = default;
+    FrameGovernor(const FrameGovernor&) = delete;
+    FrameGovernor& operator=(const FrameGovernor&) = delete;
+
+    void setActive(bool newActive, unsigned long now);
+
+    bool active = true;
+    bool applied = false;
+    unsigned long lastActivity = 0;
+    unsigned long modeSince = 0;
+    uint32_t lastFlushedPasses = 0;
+
+    // Statistics
+    unsigned long activeTime = 0;
+    unsigned long idleTime = 0;
+    uint32_t switches = 0;
+};
+
+// Global instance access
+#define FrameGov FrameGovernor::getInstance()
+
+#endif // FRAME_GOVERNOR_H
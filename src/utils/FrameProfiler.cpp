@@ -0,0 +1,98 @@
+#include "FrameProfiler.h"
+#include <stdlib.h>
+
+FrameProfiler& FrameProfiler::getInstance() {
+    static FrameProfiler instance;
+    return instance;
+}
+
+void FrameProfiler::beginFrame(uint16_t areas) {
+    inFrame = true;
+    frameStartUs = micros();
+    currentFlushUs = 0;
+    currentAreas = areas;
+}
+
+void FrameProfiler::endFrame(uint32_t pixels) {
+    if (!inFrame) return;
+    inFrame = false;
+
+    // Passes with nothing invalidated cost next to nothing; don't let them dilute the stats
+    if (currentAreas == 0) return;
+
+    uint32_t totalUs = micros() - frameStartUs;
+
+    FrameRecord& rec = frames[head];
+    rec.flushUs = currentFlushUs;
+    rec.renderUs = totalUs > currentFlushUs ? totalUs - currentFlushUs : 0;
+    rec.pixels = pixels;
+    rec.areas = currentAreas;
+    rec.tag = currentTag;
+
+    head = (head + 1) % DISP_PROFILER_FRAMES;
+    if (count < DISP_PROFILER_FRAMES) count++;
+    totalFrames++;
+}
+
+void FrameProfiler::setTag(uint8_t tag, const char* name) {
+    if (tag >= FRAME_PROFILER_MAX_TAGS) return;
+    currentTag = tag;
+    tagNames[tag] = name;
+}
+
+void FrameProfiler::reset() {
+    head = 0;
+    count = 0;
+    totalFrames = 0;
+}
+
+static int compareU32(const void* a, const void* b) {
+    uint32_t va = *(const uint32_t*)a;
+    uint32_t vb = *(const uint32_t*)b;
+    return (va > vb) - (va < vb);
+}
+
+void FrameProfiler::printPercentiles(const char* label, uint32_t* values, uint32_t n) {
+    qsort(values, n, sizeof(uint32_t), compareU32);
+    Serial.printf("  %-8s p50 %6lu  p95 %6lu  max %6lu\n", label,
+                  (unsigned long)values[n / 2],
+                  (unsigned long)values[(n * 95) / 100],
+                  (unsigned long)values[n - 1]);
+}
+
+void FrameProfiler::printSummary() {
+    Serial.printf("FrameProfiler: %lu frames recorded, last %lu:\n",
+                  (unsigned long)totalFrames, (unsigned long)count);
+    if (count == 0) return;
+
+    uint32_t values[DISP_PROFILER_FRAMES];
+
+    for (uint32_t i = 0; i < count; i++) values[i] = frames[i].renderUs;
+    printPercentiles("render", values, count);
+    for (uint32_t i = 0; i < count; i++) values[i] = frames[i].flushUs;
+    printPercentiles("flush", values, count);
+    for (uint32_t i = 0; i < count; i++) values[i] = frames[i].renderUs + frames[i].flushUs;
+    printPercentiles("total", values, count);
+    for (uint32_t i = 0; i < count; i++) values[i] = frames[i].areas;
+    printPercentiles("areas", values, count);
+    for (uint32_t i = 0; i < count; i++) values[i] = frames[i].pixels;
+    printPercentiles("pixels", values, count);
+
+    // Per-page cost, to find the pages that spend the most frame time
+    for (uint8_t tag = 0; tag < FRAME_PROFILER_MAX_TAGS; tag++) {
+        uint32_t n = 0;
+        uint32_t sumUs = 0;
+        uint32_t maxUs = 0;
+        for (uint32_t i = 0; i < count; i++) {
+            if (frames[i].tag != tag) continue;
+            uint32_t us = frames[i].renderUs + frames[i].flushUs;
+            n++;
+            sumUs += us;
+            if (us > maxUs) maxUs = us;
+        }
+        if (n == 0) continue;
+        Serial.printf("  page %-10s %4lu frames, avg %6lu us, max %6lu us\n",
+                      tagNames[tag] ? tagNames[tag] : "?",
+                      (unsigned long)n, (unsigned long)(sumUs / n), (unsigned long)maxUs);
+    }
+}
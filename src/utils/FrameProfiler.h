@@ -0,0 +1,61 @@
+#ifndef FRAME_PROFILER_H
+#define FRAME_PROFILER_H
+
+#include <Arduino.h>
+#include "../config/display_config.h"
+
+#define FRAME_PROFILER_MAX_TAGS 16
+
+// One refresh pass that had invalidated areas
+struct FrameRecord {
+    uint32_t renderUs;   // CPU time spent rendering (pass time minus flush time)
+    uint32_t flushUs;    // Time spent pushing pixels or waiting for the bus
+    uint32_t pixels;     // Pixels pushed to the panel
+    uint16_t areas;      // Invalidated areas at the start of the pass
+    uint8_t tag;         // Active page when the frame was drawn
+};
+
+// Records the last DISP_PROFILER_FRAMES refreshes and prints p50/p95/max
+class FrameProfiler {
+public:
+    static FrameProfiler& getInstance();
+
+    // Frame boundaries (called by DisplayManager around each refresh pass)
+    void beginFrame(uint16_t areas);
+    void addFlushTime(uint32_t us) { if (inFrame) currentFlushUs += us; }
+    void endFrame(uint32_t pixels);
+
+    // Attribute following frames to a page
+    void setTag(uint8_t tag, const char* name);
+
+    // Report
+    void printSummary();
+    void reset();
+    uint32_t getFrameCount() const { return count; }
+
+private:
+    FrameProfiler() = default;
+    ~FrameProfiler() = default;
+    FrameProfiler(const FrameProfiler&) = delete;
+    FrameProfiler& operator=(const FrameProfiler&) = delete;
+
+    void printPercentiles(const char* label, uint32_t* values, uint32_t n);
+
+    FrameRecord frames[DISP_PROFILER_FRAMES];
+    uint32_t head = 0;          // Next slot to write
+    uint32_t count = 0;         // Valid records (<= DISP_PROFILER_FRAMES)
+    uint32_t totalFrames = 0;   // Frames recorded since reset
+
+    bool inFrame = false;
+    uint32_t frameStartUs = 0;
+    uint32_t currentFlushUs = 0;
+    uint16_t currentAreas = 0;
+
+    uint8_t currentTag = 0;
+    const char* tagNames[FRAME_PROFILER_MAX_TAGS] = {};
+};
+
+// Global instance access
+#define FrameProf FrameProfiler::getInstance()
+
+#endif // FRAME_PROFILER_H
@@ -0,0 +1,220 @@
+#include "GestureEngine.h"
+
+static const GestureConfig noGestures = {};
+
+static const char* const typeNames[GESTURE_TYPE_COUNT] = {
+    "press", "long", "repeat", "double", "chord"
+};
+
+GestureEngine& GestureEngine::getInstance() {
+    static GestureEngine instance;
+    return instance;
+}
+
+void GestureEngine::setConfig(const GestureConfig* newConfig) {
+    config = newConfig;
+
+    // Keys held across a page change don't carry their gesture over
+    for (uint8_t k = 0; k < INPUT_KEY_COUNT; k++) {
+        keys[k].action = ACTION_NONE;
+        keys[k].tapPending = false;
+    }
+    arm();
+}
+
+void GestureEngine::onInput(const InputEvent& event) {
+    if (event.key >= INPUT_KEY_COUNT) return;
+
+    if (event.pressed) {
+        onPress(event.key, event);
+    } else {
+        onRelease(event.key);
+    }
+    arm();
+}
+
+void GestureEngine::onPress(uint8_t key, const InputEvent& event) {
+    const GestureConfig* cfg = config ? config : &noGestures;
+    KeyState& ks = keys[key];
+    ks.down = true;
+    ks.action = ACTION_NONE;
+    ks.count = 0;
+    ks.seq = event.seq;
+    ks.downMs = event.timeMs;
+
+    bool chordKey = false;
+    for (uint8_t c = 0; c < GESTURE_MAX_CHORDS; c++) {
+        uint8_t chord = cfg->chords[c];
+        if (!(chord & GESTURE_KEY(key))) continue;
+        chordKey = true;
+
+        // Partner already down and still waiting: that's the chord
+        for (uint8_t p = 0; p < INPUT_KEY_COUNT; p++) {
+            if (p == key || !(chord & GESTURE_KEY(p))) continue;
+            if (keys[p].down && keys[p].action == ACTION_CHORD_WAIT) {
+                keys[p].action = ACTION_NONE;
+                emit(GESTURE_CHORD, p, key, 0, keys[p].seq, event.timeMs);
+                return;
+            }
+        }
+    }
+
+    if (chordKey) {
+        ks.action = ACTION_CHORD_WAIT;
+        ks.deadline = ks.downMs + GESTURE_CHORD_MS;
+        return;
+    }
+
+    startPress(key);
+}
+
+void GestureEngine::startPress(uint8_t key) {
+    const GestureConfig* cfg = config ? config : &noGestures;
+    KeyState& ks = keys[key];
+
+    if (cfg->longPressKeys & GESTURE_KEY(key)) {
+        ks.action = ACTION_LONG_PRESS;
+        ks.deadline = ks.downMs + GESTURE_LONG_PRESS_MS;
+        return;
+    }
+
+    emitTap(key);
+
+    if (cfg->repeatKeys & GESTURE_KEY(key)) {
+        ks.action = ACTION_REPEAT;
+        ks.interval = GESTURE_REPEAT_START_MS;
+        ks.deadline = ks.downMs + GESTURE_REPEAT_DELAY_MS;
+    }
+}
+
+void GestureEngine::onRelease(uint8_t key) {
+    KeyState& ks = keys[key];
+    ks.down = false;
+
+    // Released before the chord partner or the long-press time: a plain press
+    Action action = ks.action;
+    ks.action = ACTION_NONE;
+    if (action == ACTION_CHORD_WAIT || action == ACTION_LONG_PRESS) {
+        emitTap(key);
+    }
+}
+
+void GestureEngine::emitTap(uint8_t key) {
+    const GestureConfig* cfg = config ? config : &noGestures;
+    KeyState& ks = keys[key];
+
+    if (!(cfg->doubleTapKeys & GESTURE_KEY(key))) {
+        emit(GESTURE_PRESS, key, key, 0, ks.seq, ks.downMs);
+        return;
+    }
+
+    if (ks.tapPending) {
+        ks.tapPending = false;
+        if (ks.downMs - ks.tapMs < GESTURE_DOUBLE_TAP_MS) {
+            emit(GESTURE_DOUBLE_TAP, key, key, 0, ks.seq, ks.downMs);
+            return;
+        }
+        // Window ran out before the timer job got to it
+        emit(GESTURE_PRESS, key, key, 0, ks.tapSeq, ks.tapMs);
+    }
+
+    // Hold the press back until the double-tap window has passed
+    ks.tapPending = true;
+    ks.tapSeq = ks.seq;
+    ks.tapMs = ks.downMs;
+}
+
+void GestureEngine::fire(uint8_t key, uint32_t now) {
+    KeyState& ks = keys[key];
+
+    switch (ks.action) {
+        case ACTION_CHORD_WAIT:
+            // No partner came; go on as a normal press
+            ks.action = ACTION_NONE;
+            startPress(key);
+            break;
+
+        case ACTION_LONG_PRESS:
+            ks.action = ACTION_NONE;
+            emit(GESTURE_LONG_PRESS, key, key, 0, ks.seq, now);
+            break;
+
+        case ACTION_REPEAT:
+            ks.count++;
+            emit(GESTURE_REPEAT, key, key, ks.count, ks.seq, now);
+
+            // The handler may have changed the page (and cleared the action)
+            if (ks.action != ACTION_REPEAT) break;
+            ks.interval = ks.interval - ks.interval / 4;
+            if (ks.interval < GESTURE_REPEAT_MIN_MS) ks.interval = GESTURE_REPEAT_MIN_MS;
+            ks.deadline += ks.interval;
+            if ((int32_t)(now - ks.deadline) > 0) ks.deadline = now + ks.interval;
+            break;
+
+        default:
+            break;
+    }
+}
+
+void GestureEngine::emit(GestureType type, uint8_t key, uint8_t key2, uint16_t count, uint16_t seq, uint32_t timeMs) {
+    emitted[type]++;
+    if (!handler) return;
+
+    Gesture gesture = { type, (InputKey)key, (InputKey)key2, count, seq, timeMs };
+    handler(gesture);
+}
+
+void GestureEngine::arm() {
+    Sched.cancel(&timerJob);
+
+    bool pending = false;
+    uint32_t next = 0;
+    for (uint8_t k = 0; k < INPUT_KEY_COUNT; k++) {
+        const KeyState& ks = keys[k];
+        if (ks.action != ACTION_NONE) {
+            if (!pending || (int32_t)(ks.deadline - next) < 0) next = ks.deadline;
+            pending = true;
+        }
+        if (ks.tapPending) {
+            uint32_t tapDeadline = ks.tapMs + GESTURE_DOUBLE_TAP_MS;
+            if (!pending || (int32_t)(tapDeadline - next) < 0) next = tapDeadline;
+            pending = true;
+        }
+    }
+    if (!pending) return;
+
+    int32_t wait = (int32_t)(next - millis());
+    timerJob = Sched.after(wait > 0 ? (uint32_t)wait : 0, onTimerJob, this, "gesture");
+}
+
+void GestureEngine::onTimerJob(void* userData) {
+    GestureEngine* self = static_cast<GestureEngine*>(userData);
+    self->timerJob = SCHED_INVALID_JOB; // One-shot, already gone
+
+    uint32_t now = millis();
+    for (uint8_t k = 0; k < INPUT_KEY_COUNT; k++) {
+        KeyState& ks = self->keys[k];
+        if (ks.tapPending && (int32_t)(now - (ks.tapMs + GESTURE_DOUBLE_TAP_MS)) >= 0) {
+            // No second tap came: deliver the press that was held back
+            ks.tapPending = false;
+            self->emit(GESTURE_PRESS, k, k, 0, ks.tapSeq, ks.tapMs);
+        }
+        if (ks.action != ACTION_NONE && (int32_t)(now - ks.deadline) >= 0) {
+            self->fire(k, now);
+        }
+    }
+    self->arm();
+}
+
+const char* GestureEngine::getTypeName(GestureType type) {
+    return type < GESTURE_TYPE_COUNT ? typeNames[type] : "?";
+}
+
+void GestureEngine::printStats() {
+    Serial.printf("GestureEngine: %lu press, %lu long, %lu repeat, %lu double, %lu chord\n",
+                  (unsigned long)emitted[GESTURE_PRESS],
+                  (unsigned long)emitted[GESTURE_LONG_PRESS],
+                  (unsigned long)emitted[GESTURE_REPEAT],
+                  (unsigned long)emitted[GESTURE_DOUBLE_TAP],
+                  (unsigned long)emitted[GESTURE_CHORD]);
+}
@@ -0,0 +1,129 @@
+#ifndef GESTURE_ENGINE_H
+#define GESTURE_ENGINE_H
+
+#include <Arduino.h>
+#include "InputManager.h"
+#include "../core/Scheduler.h"
+
+// Gesture timing (ms)
+#ifndef GESTURE_LONG_PRESS_MS
+#define GESTURE_LONG_PRESS_MS     600
+#endif
+#ifndef GESTURE_REPEAT_DELAY_MS
+#define GESTURE_REPEAT_DELAY_MS   400     // Hold time before the first repeat
+#endif
+#ifndef GESTURE_REPEAT_START_MS
+#define GESTURE_REPEAT_START_MS   200     // First repeat interval; shrinks by 1/4 per repeat
+#endif
+#ifndef GESTURE_REPEAT_MIN_MS
+#define GESTURE_REPEAT_MIN_MS     50
+#endif
+#ifndef GESTURE_DOUBLE_TAP_MS
+#define GESTURE_DOUBLE_TAP_MS     300
+#endif
+#ifndef GESTURE_CHORD_MS
+#define GESTURE_CHORD_MS          60      // Max gap between the two keys of a chord
+#endif
+
+#define GESTURE_MAX_CHORDS        2
+#define GESTURE_KEY(key)          ((uint8_t)(1u << (key)))
+
+enum GestureType : uint8_t {
+    GESTURE_PRESS = 0,      // Plain press (on release for long-press keys)
+    GESTURE_LONG_PRESS,
+    GESTURE_REPEAT,         // Key still held; count says how many repeats so far
+    GESTURE_DOUBLE_TAP,     // Second press within GESTURE_DOUBLE_TAP_MS (instead of a press)
+    GESTURE_CHORD,          // key and key2 pressed together
+    GESTURE_TYPE_COUNT
+};
+
+struct Gesture {
+    GestureType type;
+    InputKey key;
+    InputKey key2;          // Second key of a chord
+    uint16_t count;         // Repeat number (1, 2, ...)
+    uint16_t seq;           // Input event that started the gesture
+    uint32_t timeMs;        // When the input happened (press edge, or the repeat)
+};
+
+// Per-page gesture selection (bit masks of GESTURE_KEY(InputKey)).
+// Keys not listed only produce GESTURE_PRESS, exactly as plain input did.
+struct GestureConfig {
+    uint8_t repeatKeys;                 // Auto-repeat while held
+    uint8_t longPressKeys;              // Long press; the plain press comes on release
+    uint8_t doubleTapKeys;              // Double tap; the plain press waits
+                                        // GESTURE_DOUBLE_TAP_MS for a second tap
+    uint8_t chords[GESTURE_MAX_CHORDS]; // Two-key combinations; their keys wait
+                                        // GESTURE_CHORD_MS for the partner
+};
+
+typedef void (*GestureHandler)(const Gesture& gesture);
+
+// Turns debounced key changes into gestures. Hold timers (chord window,
+// long press, repeat, double-tap window) run as one scheduler job armed for
+// the earliest deadline, so nothing is polled while no key is waiting.
+class GestureEngine {
+public:
+    static GestureEngine& getInstance();
+
+    void setHandler(GestureHandler gestureHandler) { handler = gestureHandler; }
+
+    // Gestures wanted by the visible page (nullptr = presses only)
+    void setConfig(const GestureConfig* newConfig);
+
+    // Feed one debounced key change
+    void onInput(const InputEvent& event);
+
+    // Status
+    static const char* getTypeName(GestureType type);
+    void printStats();
+
+private:
+    GestureEngine() = default;
+    ~GestureEngine() = default;
+    GestureEngine(const GestureEngine&) = delete;
+    GestureEngine& operator=(const GestureEngine&) = delete;
+
+    enum Action : uint8_t {
+        ACTION_NONE = 0,
+        ACTION_CHORD_WAIT,      // Waiting for a chord partner
+        ACTION_LONG_PRESS,      // Waiting for the long-press time
+        ACTION_REPEAT           // Waiting for the next repeat
+    };
+
+    struct KeyState {
+        bool down;
+        Action action;
+        uint16_t count;
+        uint16_t interval;
+        uint16_t seq;
+        uint32_t downMs;
+        uint32_t deadline;
+        bool tapPending;        // Press held back waiting for a second tap
+        uint16_t tapSeq;
+        uint32_t tapMs;
+    };
+
+    void onPress(uint8_t key, const InputEvent& event);
+    void onRelease(uint8_t key);
+    void startPress(uint8_t key);
+    void emitTap(uint8_t key);
+    void fire(uint8_t key, uint32_t now);
+    void emit(GestureType type, uint8_t key, uint8_t key2, uint16_t count, uint16_t seq, uint32_t timeMs);
+
+    // Hold timer
+    void arm();
+    static void onTimerJob(void* userData);
+
+    KeyState keys[INPUT_KEY_COUNT] = {};
+    const GestureConfig* config = nullptr;
+    GestureHandler handler = nullptr;
+    int timerJob = SCHED_INVALID_JOB;
+
+    uint32_t emitted[GESTURE_TYPE_COUNT] = {};
+};
+
+// Global instance access
+#define Gestures GestureEngine::getInstance()
+
+#endif // GESTURE_ENGINE_H
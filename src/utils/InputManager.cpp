@@ -0,0 +1,219 @@
+#include "InputManager.h"
+#include "SleepManager.h"
+
+// Pin of each InputKey (all active LOW)
+static const uint8_t keyPins[INPUT_KEY_COUNT] = {
+    WIO_5S_UP, WIO_5S_DOWN, WIO_5S_LEFT, WIO_5S_RIGHT, WIO_5S_PRESS,
+    WIO_KEY_A, WIO_KEY_B, WIO_KEY_C
+};
+
+static const char* const keyNames[INPUT_KEY_COUNT] = {
+    "UP", "DOWN", "LEFT", "RIGHT", "PRESS", "A", "B", "C"
+};
+
+// Ring entries pack the key index and the new level into one byte
+#define RING_PRESSED_BIT 0x80
+
+InputManager& InputManager::getInstance() {
+    static InputManager instance;
+    return instance;
+}
+
+template <uint8_t Key>
+void InputManager::onEdge() {
+    InputManager& self = getInstance();
+    self.sampleLine(self.keys[Key].line);
+}
+
+void InputManager::begin(InputHandler inputHandler) {
+    static void (*const edgeHandlers[INPUT_KEY_COUNT])() = {
+        onEdge<0>, onEdge<1>, onEdge<2>, onEdge<3>,
+        onEdge<4>, onEdge<5>, onEdge<6>, onEdge<7>
+    };
+
+    handler = inputHandler;
+    uint32_t now = millis();
+
+    for (uint8_t k = 0; k < INPUT_KEY_COUNT; k++) {
+        KeyState& ks = keys[k];
+        ks.pin = keyPins[k];
+        pinMode(ks.pin, INPUT_PULLUP);
+
+        int line = digitalPinToInterrupt(ks.pin);
+        ks.line = (line == NOT_AN_INTERRUPT) ? -1 : (int8_t)line;
+        ks.sampled = ks.stable = readPin(k);
+        ks.unsettled = false;
+        ks.lastChange = now;
+    }
+
+    // Pins on the same external interrupt line (the SAMD51 EIC has 16) share
+    // one handler, which samples all of them
+    for (uint8_t k = 0; k < INPUT_KEY_COUNT; k++) {
+        KeyState& ks = keys[k];
+        if (ks.line < 0) {
+            Serial.printf("InputManager: Key %s has no interrupt, polling it\n", keyNames[k]);
+            continue;
+        }
+
+        bool shared = false;
+        for (uint8_t j = 0; j < k; j++) {
+            if (keys[j].line == ks.line) {
+                Serial.printf("InputManager: Key %s shares interrupt line %d with %s\n",
+                              keyNames[k], ks.line, keyNames[j]);
+                shared = true;
+                break;
+            }
+        }
+        if (!shared) {
+            attachInterrupt(digitalPinToInterrupt(ks.pin), edgeHandlers[k], CHANGE);
+#ifdef SLEEP_WAKE_IRQ_PRIORITY
+            // attachInterrupt() leaves the line at priority 0, above what
+            // FreeRTOS allows for the wake() in push()
+            NVIC_SetPriority((IRQn_Type)(EIC_0_IRQn + ks.line), SLEEP_WAKE_IRQ_PRIORITY);
+#endif
+        }
+    }
+
+    Serial.println("InputManager: Initialized");
+}
+
+void InputManager::sampleLine(int8_t line) {
+    uint32_t now = millis();
+    for (uint8_t k = 0; k < INPUT_KEY_COUNT; k++) {
+        KeyState& ks = keys[k];
+        if (ks.line != line) continue;
+
+        bool level = readPin(k);
+        if (level != ks.sampled) {
+            ks.sampled = level;
+            push(k, level, now);
+        }
+    }
+}
+
+void InputManager::push(uint8_t key, bool pressed, uint32_t timeMs) {
+    uint8_t h = head;
+    if ((uint8_t)(h - tail) >= INPUT_RING_SIZE) {
+        overflows = overflows + 1;
+        return;
+    }
+
+    uint8_t slot = h & (INPUT_RING_SIZE - 1);
+    ringKey[slot] = key | (pressed ? RING_PRESSED_BIT : 0);
+    ringTime[slot] = timeMs;
+
+    // Publish the entry before moving the head
+    __sync_synchronize();
+    head = h + 1;
+
+    SleepMgr.wake();
+}
+
+bool InputManager::pop(uint8_t& key, bool& pressed, uint32_t& timeMs) {
+    uint8_t t = tail;
+    if (t == head) return false;
+
+    // Read the entry only after seeing the head that published it
+    __sync_synchronize();
+    uint8_t slot = t & (INPUT_RING_SIZE - 1);
+    key = ringKey[slot] & ~RING_PRESSED_BIT;
+    pressed = (ringKey[slot] & RING_PRESSED_BIT) != 0;
+    timeMs = ringTime[slot];
+
+    __sync_synchronize();
+    tail = t + 1;
+    return true;
+}
+
+uint8_t InputManager::poll() {
+    uint8_t delivered = 0;
+
+    uint8_t depth = head - tail;
+    if (depth > stats.maxDepth) stats.maxDepth = depth;
+
+    uint8_t key;
+    bool pressed;
+    uint32_t timeMs;
+    while (pop(key, pressed, timeMs)) {
+        stats.edges++;
+        if (apply(key, pressed, timeMs)) delivered++;
+    }
+
+    // Keys without an interrupt, and keys whose last edge fell inside the
+    // debounce window: once the window is over, trust the pin level
+    uint32_t now = millis();
+    for (uint8_t k = 0; k < INPUT_KEY_COUNT; k++) {
+        KeyState& ks = keys[k];
+        bool recheck = ks.line < 0 ||
+                       (ks.unsettled && now - ks.lastChange >= INPUT_DEBOUNCE_MS);
+        if (!recheck) continue;
+
+        ks.unsettled = false;
+        bool level = readPin(k);
+        if (level != ks.stable && apply(k, level, now)) delivered++;
+    }
+
+    stats.overflows = overflows;
+    return delivered;
+}
+
+bool InputManager::apply(uint8_t key, bool pressed, uint32_t timeMs) {
+    KeyState& ks = keys[key];
+    if (pressed == ks.stable) {
+        stats.bounces++;
+        return false;
+    }
+
+    // Signed, as a queued edge may predate a change made by the re-check
+    if ((int32_t)(timeMs - ks.lastChange) < INPUT_DEBOUNCE_MS) {
+        ks.unsettled = true;
+        stats.bounces++;
+        return false;
+    }
+
+    ks.stable = pressed;
+    ks.lastChange = timeMs;
+    ks.unsettled = false;
+    stats.events++;
+
+    if (handler) {
+        InputEvent event = { (InputKey)key, pressed, (uint16_t)stats.events, timeMs };
+        handler(event);
+    }
+    return true;
+}
+
+bool InputManager::readPin(uint8_t key) const {
+    return digitalRead(keys[key].pin) == LOW;
+}
+
+uint32_t InputManager::msUntilSettle() const {
+    uint32_t now = millis();
+    uint32_t next = UINT32_MAX;
+
+    for (uint8_t k = 0; k < INPUT_KEY_COUNT; k++) {
+        const KeyState& ks = keys[k];
+        uint32_t wait;
+        if (ks.line < 0) {
+            wait = INPUT_DEBOUNCE_MS;
+        } else if (ks.unsettled) {
+            uint32_t elapsed = now - ks.lastChange;
+            wait = elapsed >= INPUT_DEBOUNCE_MS ? 0 : INPUT_DEBOUNCE_MS - elapsed;
+        } else {
+            continue;
+        }
+        if (wait < next) next = wait;
+    }
+    return next;
+}
+
+const char* InputManager::getKeyName(InputKey key) {
+    return key < INPUT_KEY_COUNT ? keyNames[key] : "?";
+}
+
+void InputManager::printStats() {
+    Serial.printf("InputManager: %lu edges, %lu bounces, %lu events, %lu lost, max queue %u\n",
+                  (unsigned long)stats.edges, (unsigned long)stats.bounces,
+                  (unsigned long)stats.events, (unsigned long)stats.overflows,
+                  (unsigned)stats.maxDepth);
+}
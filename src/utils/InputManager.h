@@ -0,0 +1,117 @@
+#ifndef INPUT_MANAGER_H
+#define INPUT_MANAGER_H
+
+#include <Arduino.h>
+
+// Edge events buffered between the interrupts and the loop (power of two)
+#ifndef INPUT_RING_SIZE
+#define INPUT_RING_SIZE     32
+#endif
+#if (INPUT_RING_SIZE & (INPUT_RING_SIZE - 1)) != 0 || INPUT_RING_SIZE > 128
+#error "INPUT_RING_SIZE must be a power of two up to 128"
+#endif
+
+// Per-key debounce window: edges closer than this to the last accepted one are bounce
+#ifndef INPUT_DEBOUNCE_MS
+#define INPUT_DEBOUNCE_MS   30
+#endif
+
+enum InputKey : uint8_t {
+    INPUT_UP = 0,
+    INPUT_DOWN,
+    INPUT_LEFT,
+    INPUT_RIGHT,
+    INPUT_PRESS,
+    INPUT_KEY_A,
+    INPUT_KEY_B,
+    INPUT_KEY_C,
+    INPUT_KEY_COUNT
+};
+
+// A debounced key change
+struct InputEvent {
+    InputKey key;
+    bool pressed;
+    uint16_t seq;       // Running number of delivered events
+    uint32_t timeMs;    // When the edge happened (not when it was read)
+};
+
+typedef void (*InputHandler)(const InputEvent& event);
+
+// Input counters
+struct InputStats {
+    uint32_t edges;       // Raw edges taken from the ring
+    uint32_t bounces;     // Edges dropped by the debouncer
+    uint32_t events;      // Debounced changes delivered
+    uint32_t overflows;   // Edges lost because the ring was full
+    uint8_t maxDepth;     // Deepest the ring has been when drained
+};
+
+// Captures the joystick and the A/B/C keys with pin-change interrupts.
+// The interrupts only timestamp the new pin level and push it into a
+// single-producer/single-consumer ring; poll() drains it from the loop and
+// debounces every key on its own, so one key never blocks another and
+// presses aren't lost while the loop is busy.
+class InputManager {
+public:
+    static InputManager& getInstance();
+
+    // Configure the pins and attach the interrupts
+    void begin(InputHandler handler);
+
+    // Debounce the queued edges and call the handler for each change.
+    // Returns the number of events delivered.
+    uint8_t poll();
+
+    // Milliseconds until a key's debounce window ends and its level must be
+    // re-checked (UINT32_MAX if none is pending)
+    uint32_t msUntilSettle() const;
+
+    // Status
+    bool isPressed(InputKey key) const { return key < INPUT_KEY_COUNT && keys[key].stable; }
+    static const char* getKeyName(InputKey key);
+    const InputStats& getStats() const { return stats; }
+    void printStats();
+
+private:
+    InputManager() = default;
+    ~InputManager() = default;
+    InputManager(const InputManager&) = delete;
+    InputManager& operator=(const InputManager&) = delete;
+
+    struct KeyState {
+        uint8_t pin;
+        int8_t line;          // External interrupt line, -1 = polled
+        bool sampled;         // Last level seen by the producer
+        bool stable;          // Debounced level
+        bool unsettled;       // An edge was dropped inside the window
+        uint32_t lastChange;  // When 'stable' last changed
+    };
+
+    // Producer side (interrupt context)
+    template <uint8_t Key> static void onEdge();
+    void sampleLine(int8_t line);
+    void push(uint8_t key, bool pressed, uint32_t timeMs);
+
+    // Consumer side (loop)
+    bool pop(uint8_t& key, bool& pressed, uint32_t& timeMs);
+    bool apply(uint8_t key, bool pressed, uint32_t timeMs);
+    bool readPin(uint8_t key) const;
+
+    KeyState keys[INPUT_KEY_COUNT] = {};
+    InputHandler handler = nullptr;
+
+    // Ring: head is written only by the interrupts, tail only by the loop
+    uint8_t ringKey[INPUT_RING_SIZE];
+    uint32_t ringTime[INPUT_RING_SIZE];
+    volatile uint8_t head = 0;
+    volatile uint8_t tail = 0;
+    volatile uint32_t overflows = 0;
+
+    InputStats stats = {};
+};
+
+// Global instance access
+#define InputMgr InputManager::getInstance()
+
+#endif // INPUT_MANAGER_H
@@ -0,0 +1,295 @@
+#include "InputTrace.h"
+
+#if defined(SIMULATOR_BUILD)
+#include <cstdio>
+#elif defined(ARDUINO_ARCH_SAMD)
+#include "Seeed_FS.h"
+#include "SD/Seeed_SD.h"
+#define INPUT_TRACE_HAS_SD 1
+#endif
+
+#define TRACE_HEADER_SIZE   8
+#define TRACE_RECORD_SIZE   3
+#define TRACE_PRESSED_BIT   0x80
+
+// File image of a trace; save() and load() run on the UI loop only
+static uint8_t fileBuf[TRACE_HEADER_SIZE + INPUT_TRACE_MAX_EVENTS * TRACE_RECORD_SIZE];
+
+#if INPUT_TRACE_HAS_SD
+static bool beginSD() {
+    // The music page may have mounted it already; begin() again is harmless
+    static bool sdReady = false;
+    if (!sdReady) sdReady = SD.begin(SDCARD_SS_PIN, SDCARD_SPI, 4000000UL);
+    return sdReady;
+}
+#endif
+
+InputTrace& InputTrace::getInstance() {
+    static InputTrace instance;
+    return instance;
+}
+
+void InputTrace::startRecording() {
+    if (isReplaying()) stopReplay();
+
+    count = 0;
+    dropped = 0;
+    lastRecordMs = millis();
+    recording = true;
+    Serial.println("InputTrace: Recording started");
+}
+
+void InputTrace::stopRecording() {
+    if (!recording) return;
+    recording = false;
+    Serial.printf("InputTrace: Recording stopped, %u events\n", (unsigned)count);
+}
+
+void InputTrace::record(const InputEvent& event) {
+    if (!recording) return;
+
+    // Signed: an edge may be timestamped before the recording started
+    int32_t dt = (int32_t)(event.timeMs - lastRecordMs);
+    if (dt < 0) dt = 0;
+    lastRecordMs = event.timeMs;
+
+    uint8_t code = event.key | (event.pressed ? TRACE_PRESSED_BIT : 0);
+    if (!append((uint32_t)dt, code)) {
+        dropped++;
+        recording = false;
+        Serial.printf("InputTrace: Trace full (%u events), recording stopped\n", (unsigned)count);
+    }
+}
+
+bool InputTrace::append(uint32_t dtMs, uint8_t code) {
+    // Gaps that don't fit in 16 bits become wait records
+    while (dtMs > 0xFFFF) {
+        if (count >= INPUT_TRACE_MAX_EVENTS) return false;
+        records[count++] = { 0xFFFF, INPUT_TRACE_WAIT };
+        dtMs -= 0xFFFF;
+    }
+    if (count >= INPUT_TRACE_MAX_EVENTS) return false;
+    records[count++] = { (uint16_t)dtMs, code };
+    return true;
+}
+
+bool InputTrace::startReplay(TraceReplayMode replayMode, InputHandler handler, void (*done)()) {
+    if (!handler || count == 0) return false;
+    if (isReplaying()) stopReplay();
+    stopRecording();
+
+    mode = replayMode;
+    replayHandler = handler;
+    replayDone = done;
+    replayIndex = 0;
+    heldKeys = 0;
+    replayStartMs = millis();
+    replayOffsetMs = 0;
+
+    Serial.printf("InputTrace: Replaying %u events (%s)\n", (unsigned)count,
+                  mode == TRACE_REPLAY_FAST ? "fast" : "real time");
+    scheduleNext();
+    return true;
+}
+
+uint32_t InputTrace::replayGap(uint16_t index) const {
+    const Record& r = records[index];
+    if (mode == TRACE_REPLAY_REALTIME || heldKeys != 0) return r.dtMs;
+
+    // Fast: idle time is skipped, but holds (long presses, repeats, chords)
+    // keep their length so the same gestures come out
+    if (r.code == INPUT_TRACE_WAIT) return 0;
+    return r.dtMs < INPUT_TRACE_FAST_GAP_MS ? r.dtMs : INPUT_TRACE_FAST_GAP_MS;
+}
+
+void InputTrace::scheduleNext() {
+    // Scheduled against the start of the replay so lateness doesn't add up
+    replayOffsetMs += replayGap(replayIndex);
+    uint32_t elapsed = millis() - replayStartMs;
+    uint32_t delayMs = replayOffsetMs > elapsed ? replayOffsetMs - elapsed : 0;
+
+    replayJob = Sched.after(delayMs, onReplayJob, this, "replay");
+    if (replayJob == SCHED_INVALID_JOB) {
+        Serial.println("InputTrace: No scheduler slot, replay aborted");
+        stopReplay();
+    }
+}
+
+void InputTrace::onReplayJob(void* userData) {
+    InputTrace* self = static_cast<InputTrace*>(userData);
+    self->replayJob = SCHED_INVALID_JOB;
+
+    const Record& r = self->records[self->replayIndex++];
+    uint8_t key = r.code & ~TRACE_PRESSED_BIT;
+    if (r.code != INPUT_TRACE_WAIT && key < INPUT_KEY_COUNT) {
+        bool pressed = (r.code & TRACE_PRESSED_BIT) != 0;
+        if (pressed) {
+            self->heldKeys |= (uint8_t)(1u << key);
+        } else {
+            self->heldKeys &= (uint8_t)~(1u << key);
+        }
+
+        uint32_t now = millis();
+        InputEvent event = { (InputKey)key, pressed, ++self->replaySeq, now };
+        self->replayHandler(event);
+        if (!self->isReplaying()) return; // Stopped by the handler
+    }
+
+    if (self->replayIndex < self->count) {
+        self->scheduleNext();
+    } else {
+        self->finishReplay();
+    }
+}
+
+void InputTrace::stopReplay() {
+    if (!isReplaying()) return;
+    Sched.cancel(&replayJob);
+    finishReplay();
+}
+
+void InputTrace::finishReplay() {
+    // Don't leave keys pressed in the gesture engine (stopped mid-hold, or
+    // the recording ended while a key was down)
+    uint32_t now = millis();
+    for (uint8_t k = 0; k < INPUT_KEY_COUNT; k++) {
+        if (heldKeys & (1u << k)) {
+            InputEvent event = { (InputKey)k, false, ++replaySeq, now };
+            replayHandler(event);
+        }
+    }
+    heldKeys = 0;
+
+    Serial.printf("InputTrace: Replay ended after %u of %u events, %lu ms\n",
+                  (unsigned)replayIndex, (unsigned)count,
+                  (unsigned long)(millis() - replayStartMs));
+    replays++;
+
+    void (*done)() = replayDone;
+    replayHandler = nullptr;
+    replayDone = nullptr;
+    if (done) done();
+}
+
+size_t InputTrace::serialize(uint8_t* out, size_t size) const {
+    size_t needed = TRACE_HEADER_SIZE + (size_t)count * TRACE_RECORD_SIZE;
+    if (size < needed) return 0;
+
+    memcpy(out, INPUT_TRACE_MAGIC, 4);
+    out[4] = INPUT_TRACE_VERSION;
+    out[5] = 0;
+    out[6] = count & 0xFF;
+    out[7] = count >> 8;
+
+    uint8_t* p = out + TRACE_HEADER_SIZE;
+    for (uint16_t i = 0; i < count; i++) {
+        *p++ = records[i].dtMs & 0xFF;
+        *p++ = records[i].dtMs >> 8;
+        *p++ = records[i].code;
+    }
+    return needed;
+}
+
+bool InputTrace::deserialize(const uint8_t* in, size_t size) {
+    if (size < TRACE_HEADER_SIZE || memcmp(in, INPUT_TRACE_MAGIC, 4) != 0) {
+        Serial.println("InputTrace: Not a trace file");
+        return false;
+    }
+    if (in[4] != INPUT_TRACE_VERSION) {
+        Serial.printf("InputTrace: Unsupported trace version %u\n", (unsigned)in[4]);
+        return false;
+    }
+
+    uint16_t n = in[6] | (in[7] << 8);
+    if (n > INPUT_TRACE_MAX_EVENTS || size < TRACE_HEADER_SIZE + (size_t)n * TRACE_RECORD_SIZE) {
+        Serial.printf("InputTrace: Trace of %u events is truncated or too long\n", (unsigned)n);
+        return false;
+    }
+
+    const uint8_t* p = in + TRACE_HEADER_SIZE;
+    for (uint16_t i = 0; i < n; i++, p += TRACE_RECORD_SIZE) {
+        records[i].dtMs = p[0] | (p[1] << 8);
+        records[i].code = p[2];
+    }
+    count = n;
+    return true;
+}
+
+bool InputTrace::save(const char* path) {
+    size_t size = serialize(fileBuf, sizeof(fileBuf));
+    if (!path || size == 0) return false;
+
+#if defined(SIMULATOR_BUILD)
+    FILE* f = fopen(path, "wb");
+    bool ok = f && fwrite(fileBuf, 1, size, f) == size;
+    if (f) fclose(f);
+#elif INPUT_TRACE_HAS_SD
+    bool ok = false;
+    if (beginSD()) {
+        SD.remove(path);
+        File f = SD.open(path, FILE_WRITE);
+        if (f) {
+            ok = f.write(fileBuf, size) == size;
+            f.close();
+        }
+    }
+#else
+    bool ok = false;
+#endif
+
+    if (ok) {
+        Serial.printf("InputTrace: Saved %u events to %s\n", (unsigned)count, path);
+    } else {
+        Serial.printf("InputTrace: Cannot write %s\n", path);
+    }
+    return ok;
+}
+
+bool InputTrace::load(const char* path) {
+    if (!path) return false;
+    if (isReplaying()) stopReplay();
+    stopRecording();
+
+    size_t size = 0;
+#if defined(SIMULATOR_BUILD)
+    FILE* f = fopen(path, "rb");
+    if (f) {
+        size = fread(fileBuf, 1, sizeof(fileBuf), f);
+        fclose(f);
+    }
+#elif INPUT_TRACE_HAS_SD
+    if (beginSD()) {
+        File f = SD.open(path, FILE_READ);
+        if (f) {
+            size = f.read(fileBuf, sizeof(fileBuf));
+            f.close();
+        }
+    }
+#endif
+
+    if (size == 0) {
+        Serial.printf("InputTrace: Cannot read %s\n", path);
+        return false;
+    }
+    if (!deserialize(fileBuf, size)) return false;
+
+    Serial.printf("InputTrace: Loaded %u events from %s\n", (unsigned)count, path);
+    return true;
+}
+
+void InputTrace::dump() {
+    size_t size = serialize(fileBuf, sizeof(fileBuf));
+
+    Serial.printf("InputTrace: %u events, %u bytes:\n", (unsigned)count, (unsigned)size);
+    for (size_t i = 0; i < size; i++) {
+        Serial.printf("%02x", fileBuf[i]);
+        if ((i & 31) == 31 || i + 1 == size) Serial.println();
+    }
+}
+
+void InputTrace::printStats() {
+    Serial.printf("InputTrace: %u events%s%s, %lu dropped, %lu replays\n",
+                  (unsigned)count, recording ? ", recording" : "",
+                  isReplaying() ? ", replaying" : "",
+                  (unsigned long)dropped, (unsigned long)replays);
+}
@@ -0,0 +1,105 @@
+#ifndef INPUT_TRACE_H
+#define INPUT_TRACE_H
+
+#include <Arduino.h>
+#include "InputManager.h"
+#include "GestureEngine.h"
+#include "../core/Scheduler.h"
+
+// Events one trace can hold (3 bytes each)
+#ifndef INPUT_TRACE_MAX_EVENTS
+#define INPUT_TRACE_MAX_EVENTS  512
+#endif
+
+// Fast replay: longest idle gap kept; just over the double-tap window so
+// separate taps don't merge into one
+#ifndef INPUT_TRACE_FAST_GAP_MS
+#define INPUT_TRACE_FAST_GAP_MS (GESTURE_DOUBLE_TAP_MS + 50)
+#endif
+
+#define INPUT_TRACE_MAGIC       "WIOT"
+#define INPUT_TRACE_VERSION     1
+#define INPUT_TRACE_WAIT        0x7F    // Record code: no key, just time passing
+
+enum TraceReplayMode : uint8_t {
+    TRACE_REPLAY_REALTIME = 0,  // Original timing
+    TRACE_REPLAY_FAST           // Idle gaps shortened, hold times kept
+};
+
+// Records the debounced key events of a session and plays them back into
+// the same handler, so a navigation session can be repeated exactly
+// before and after a change and the frame/latency stats compared. Events
+// are recorded ahead of the gesture engine, so long presses, repeats and
+// chords are re-derived from the replayed timing.
+//
+// File format (little-endian): "WIOT", version, 0, uint16 count, then
+// count records of { uint16 ms since the previous record, uint8 code }
+// with code = key | 0x80 when pressed, or INPUT_TRACE_WAIT for gaps
+// longer than 65 s. Stored on the SD card, or in a host file in
+// SIMULATOR_BUILD; dump() prints it as hex over serial.
+class InputTrace {
+public:
+    static InputTrace& getInstance();
+
+    // Recording
+    void startRecording();
+    void stopRecording();
+    void record(const InputEvent& event);   // No-op unless recording
+    bool isRecording() const { return recording; }
+    uint16_t getCount() const { return count; }
+
+    // Replay into handler; done is called when the trace ends or is stopped
+    bool startReplay(TraceReplayMode mode, InputHandler handler, void (*done)());
+    void stopReplay();
+    bool isReplaying() const { return replayHandler != nullptr; }
+
+    // Storage
+    bool save(const char* path);
+    bool load(const char* path);
+    void dump();                            // Hex over serial
+
+    void printStats();
+
+private:
+    InputTrace() = default;
+    ~InputTrace() = default;
+    InputTrace(const InputTrace&) = delete;
+    InputTrace& operator=(const InputTrace&) = delete;
+
+    struct Record {
+        uint16_t dtMs;
+        uint8_t code;
+    };
+
+    bool append(uint32_t dtMs, uint8_t code);
+    uint32_t replayGap(uint16_t index) const;
+    void scheduleNext();
+    void finishReplay();
+    static void onReplayJob(void* userData);
+
+    size_t serialize(uint8_t* out, size_t size) const;
+    bool deserialize(const uint8_t* in, size_t size);
+
+    Record records[INPUT_TRACE_MAX_EVENTS];
+    uint16_t count = 0;
+    bool recording = false;
+    uint32_t lastRecordMs = 0;
+    uint32_t dropped = 0;
+
+    // Replay
+    TraceReplayMode mode = TRACE_REPLAY_REALTIME;
+    InputHandler replayHandler = nullptr;
+    void (*replayDone)() = nullptr;
+    int replayJob = SCHED_INVALID_JOB;
+    uint16_t replayIndex = 0;
+    uint8_t heldKeys = 0;                   // Pressed in the replay so far
+    uint16_t replaySeq = 0;
+    uint32_t replayStartMs = 0;
+    uint32_t replayOffsetMs = 0;            // Trace time of the next event
+    uint32_t replays = 0;
+};
+
+// Global instance access
+#define InputTrc InputTrace::getInstance()
+
+#endif // INPUT_TRACE_H
@@ -0,0 +1,156 @@
+#include "LatencyTracker.h"
+#include "lvgl.h"
+
+LatencyTracker& LatencyTracker::getInstance() {
+    static LatencyTracker instance;
+    return instance;
+}
+
+uint16_t LatencyTracker::invalidatedAreas() {
+    lv_disp_t* disp = lv_disp_get_default();
+    return disp ? disp->inv_p : 0;
+}
+
+void LatencyTracker::beginDispatch(const InputEvent& event) {
+    uint32_t now = millis();
+
+    if (pendingCount >= LATENCY_MAX_PENDING) {
+        dropped++;
+        dispatching = -1;
+        return;
+    }
+
+    Pending& p = pending[pendingCount];
+    p.seq = event.seq;
+    p.key = event.key;
+    p.page = currentPage;
+    p.inputMs = event.timeMs;
+    p.dispatchMs = now;
+    p.handlerMs = 0;
+    p.invalidated = false;
+    p.idlePasses = 0;
+    dispatching = pendingCount++;
+    invBefore = invalidatedAreas();
+
+    uint32_t queueMs = now - event.timeMs;
+    if (queueMs > maxQueueMs) maxQueueMs = queueMs;
+    lastSeq = event.seq;
+}
+
+void LatencyTracker::endDispatch() {
+    if (dispatching < 0) return;
+    Pending& p = pending[dispatching];
+    p.handlerMs = millis() - p.dispatchMs;
+    p.invalidated = invalidatedAreas() != invBefore;
+    dispatching = -1;
+}
+
+void LatencyTracker::completePending() {
+    uint32_t now = millis();
+
+    for (uint8_t i = 0; i < pendingCount; i++) {
+        Pending& p = pending[i];
+
+        // Flushed from inside the handler (e.g. a page that waits in a loop)
+        if (i == dispatching) {
+            p.handlerMs = now - p.dispatchMs;
+            p.invalidated = true;
+            dispatching = -1;
+        }
+
+        uint32_t latencyMs = now - p.inputMs;
+        if (!p.invalidated) indirect++;
+        if (p.page < LATENCY_MAX_PAGES) addSample(pageHist[p.page], latencyMs, p.handlerMs);
+        if (p.key < INPUT_KEY_COUNT) addSample(keyHist[p.key], latencyMs, p.handlerMs);
+    }
+    pendingCount = 0;
+}
+
+void LatencyTracker::expirePending() {
+    // Inputs the screen has had time to show but didn't (e.g. a key the page
+    // ignores). Not based on elapsed time: while the loop is blocked no pass
+    // runs, and the late flush is still recorded.
+    uint8_t kept = 0;
+    for (uint8_t i = 0; i < pendingCount; i++) {
+        Pending& p = pending[i];
+        if (i != dispatching && !p.invalidated && ++p.idlePasses >= LATENCY_IDLE_PASSES) {
+            noRedraw++;
+            continue;
+        }
+        if (dispatching == i) dispatching = kept;
+        pending[kept++] = p;
+    }
+    pendingCount = kept;
+}
+
+void LatencyTracker::addSample(LatencyHistogram& hist, uint32_t ms, uint32_t handlerMs) {
+    uint8_t bucket = 0;
+    while (bucket < LATENCY_BUCKETS - 1 && ms >= (1u << bucket)) bucket++;
+
+    if (hist.buckets[bucket] < UINT16_MAX) hist.buckets[bucket]++;
+    hist.count++;
+    hist.sumMs += ms;
+    if (ms > hist.maxMs) hist.maxMs = ms;
+    if (handlerMs > hist.maxHandlerMs) hist.maxHandlerMs = handlerMs;
+}
+
+void LatencyTracker::setPage(uint8_t id, const char* name) {
+    if (id >= LATENCY_MAX_PAGES) return;
+    currentPage = id;
+    pageNames[id] = name;
+}
+
+void LatencyTracker::reset() {
+    memset(pageHist, 0, sizeof(pageHist));
+    memset(keyHist, 0, sizeof(keyHist));
+    pendingCount = 0;
+    dispatching = -1;
+    maxQueueMs = 0;
+    noRedraw = 0;
+    indirect = 0;
+    dropped = 0;
+}
+
+void LatencyTracker::printHistogram(const char* label, const LatencyHistogram& hist) {
+    if (hist.count == 0) return;
+
+    Serial.printf("  %-10s", label);
+    for (uint8_t b = 0; b < LATENCY_BUCKETS; b++) {
+        Serial.printf(" %4u", (unsigned)hist.buckets[b]);
+    }
+    Serial.printf(" %5lu %5lu %5lu\n",
+                  (unsigned long)(hist.sumMs / hist.count),
+                  (unsigned long)hist.maxMs,
+                  (unsigned long)hist.maxHandlerMs);
+}
+
+void LatencyTracker::printReport() {
+    uint32_t samples = 0;
+    for (uint8_t k = 0; k < INPUT_KEY_COUNT; k++) samples += keyHist[k].count;
+
+    Serial.printf("LatencyTracker: %lu inputs to flush (last #%u), %lu without redraw, %lu dropped, max queue %lu ms\n",
+                  (unsigned long)samples, (unsigned)lastSeq,
+                  (unsigned long)noRedraw, (unsigned long)dropped,
+                  (unsigned long)maxQueueMs);
+    // The next flush after an input is not necessarily its own redraw
+    Serial.printf("  %lu of them invalidated nothing in the handler (flush from an animation, job or other redraw)\n",
+                  (unsigned long)indirect);
+    if (samples == 0) return;
+
+    Serial.printf("  %-10s", "ms");
+    for (uint8_t b = 0; b < LATENCY_BUCKETS - 1; b++) {
+        char head[8];
+        snprintf(head, sizeof(head), "<%u", 1u << b);
+        Serial.printf(" %4s", head);
+    }
+    Serial.printf(" %4s %5s %5s %5s\n", "more", "avg", "max", "hndlr");
+
+    for (uint8_t id = 0; id < LATENCY_MAX_PAGES; id++) {
+        printHistogram(pageNames[id] ? pageNames[id] : "?", pageHist[id]);
+    }
+    for (uint8_t k = 0; k < INPUT_KEY_COUNT; k++) {
+        char label[12];
+        snprintf(label, sizeof(label), "key %s", InputManager::getKeyName((InputKey)k));
+        printHistogram(label, keyHist[k]);
+    }
+}
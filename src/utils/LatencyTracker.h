@@ -0,0 +1,93 @@
+#ifndef LATENCY_TRACKER_H
+#define LATENCY_TRACKER_H
+
+#include <Arduino.h>
+#include "../config/display_config.h"
+#include "InputManager.h"
+
+#define LATENCY_MAX_PAGES    10     // Page IDs tracked (PageManager MAX_PAGES)
+#define LATENCY_MAX_PENDING  4      // Inputs waiting for their first flush
+#define LATENCY_BUCKETS      11     // <1, <2, <4 ... <512, >=512 ms
+#define LATENCY_IDLE_PASSES  2      // Refresh passes without a flush before an input counts as no redraw
+
+// Latency distribution of one page or key
+struct LatencyHistogram {
+    uint16_t buckets[LATENCY_BUCKETS];
+    uint32_t count;
+    uint32_t sumMs;
+    uint32_t maxMs;
+    uint32_t maxHandlerMs;   // Longest time spent inside the input handler
+};
+
+// Measures input-to-photon latency: every input event is tagged when it is
+// dispatched and completed by the first display flush after it, however
+// late (a handler that blocks shows up in the top bucket). Each sample is
+// split into queue wait (edge to dispatch), handler time (inside AppManager
+// and the page) and the wait for the redraw. A flush is not tied to the
+// input that caused it: inputs whose handler invalidated nothing are counted
+// as indirect, since their flush may come from an animation, a finished job
+// or an unrelated redraw such as a clock label.
+class LatencyTracker {
+public:
+    static LatencyTracker& getInstance();
+
+    // Around the dispatch of one input event to the app
+    void beginDispatch(const InputEvent& event);
+    void endDispatch();
+
+    // First pixels of a refresh go to the panel (called by DisplayManager)
+    void onFlush() { if (pendingCount) completePending(); }
+    // A refresh pass ended; flushed = it sent pixels (called by DisplayManager)
+    void onRefreshPass(bool flushed) { if (pendingCount && !flushed) expirePending(); }
+
+    // Page that receives the following inputs (called by PageManager)
+    void setPage(uint8_t id, const char* name);
+
+    // Report
+    void printReport();
+    void reset();
+
+private:
+    LatencyTracker() = default;
+    ~LatencyTracker() = default;
+    LatencyTracker(const LatencyTracker&) = delete;
+    LatencyTracker& operator=(const LatencyTracker&) = delete;
+
+    struct Pending {
+        uint16_t seq;
+        uint8_t key;
+        uint8_t page;
+        uint32_t inputMs;
+        uint32_t dispatchMs;
+        uint32_t handlerMs;
+        bool invalidated;       // The handler marked something for redraw
+        uint8_t idlePasses;     // Refresh passes since dispatch that sent nothing
+    };
+
+    void completePending();
+    void expirePending();
+    static uint16_t invalidatedAreas();
+    static void addSample(LatencyHistogram& hist, uint32_t ms, uint32_t handlerMs);
+    static void printHistogram(const char* label, const LatencyHistogram& hist);
+
+    Pending pending[LATENCY_MAX_PENDING];
+    uint8_t pendingCount = 0;
+    int8_t dispatching = -1;        // Slot of the event being dispatched
+    uint16_t invBefore = 0;         // Invalidated areas when the dispatch began
+
+    uint8_t currentPage = 0;
+    const char* pageNames[LATENCY_MAX_PAGES] = {};
+
+    LatencyHistogram pageHist[LATENCY_MAX_PAGES] = {};
+    LatencyHistogram keyHist[INPUT_KEY_COUNT] = {};
+    uint32_t maxQueueMs = 0;
+    uint32_t noRedraw = 0;          // Inputs followed by refresh passes that sent nothing
+    uint32_t indirect = 0;          // Samples whose handler invalidated nothing
+    uint32_t dropped = 0;           // Inputs that found the pending table full
+    uint16_t lastSeq = 0;
+};
+
+// Global instance access
+#define LatencyTrk LatencyTracker::getInstance()
+
+#endif // LATENCY_TRACKER_H
@@ -0,0 +1,124 @@
+#include "LoopWatchdog.h"
+
+#if APP_HW_WATCHDOG_MS > 0 && !defined(__SAMD51__)
+#error "APP_HW_WATCHDOG_MS needs the SAMD51 watchdog"
+#endif
+
+static const char* const stageNames[LOOP_STAGE_COUNT] = { "tasks", "lvgl", "input", "sched" };
+
+LoopWatchdog& LoopWatchdog::getInstance() {
+    static LoopWatchdog instance;
+    return instance;
+}
+
+void LoopWatchdog::begin() {
+#if APP_HW_WATCHDOG_MS > 0
+    if (RSTC->RCAUSE.bit.WDT) {
+        Serial.println("LoopWatchdog: Last reset was caused by the hardware watchdog");
+    }
+
+    // Clocked at ~1 kHz; period is 8 << PER cycles, up to 16384
+    uint8_t per = 0;
+    while (per < WDT_CONFIG_PER_CYC16384_Val && (8UL << per) < APP_HW_WATCHDOG_MS) {
+        per++;
+    }
+
+    WDT->CTRLA.reg = 0;
+    while (WDT->SYNCBUSY.reg) {}
+    WDT->CONFIG.reg = WDT_CONFIG_PER(per);
+    WDT->CTRLA.reg = WDT_CTRLA_ENABLE;
+    while (WDT->SYNCBUSY.reg) {}
+    hardwareArmed = true;
+
+    Serial.printf("LoopWatchdog: Hardware watchdog armed (%lu ms)\n", 8UL << per);
+#endif
+}
+
+void LoopWatchdog::beginPass() {
+    // With APP_LOOP_WATCHDOG=0 only the hardware watchdog is fed
+    if (!APP_LOOP_WATCHDOG) return;
+
+    uint32_t now = millis();
+    inPass = true;
+    passStartMs = now;
+    segmentStartMs = now;
+    stage = LOOP_STAGE_TASKS;
+    detail = nullptr;
+    slowest.segmentMs = 0;
+    slowest.stage = LOOP_STAGE_TASKS;
+    slowest.detail = nullptr;
+}
+
+void LoopWatchdog::mark(LoopStage newStage, const char* newDetail) {
+    if (!inPass) return;
+    closeSegment(millis());
+    stage = newStage;
+    detail = newDetail;
+}
+
+void LoopWatchdog::closeSegment(uint32_t now) {
+    uint32_t ms = now - segmentStartMs;
+    segmentStartMs = now;
+
+    if (ms > stageMaxMs[stage]) stageMaxMs[stage] = ms;
+    if (ms > slowest.segmentMs) {
+        slowest.segmentMs = ms;
+        slowest.stage = stage;
+        slowest.detail = detail;
+    }
+}
+
+void LoopWatchdog::endPass(const char* page) {
+    feedHardware();
+    if (!inPass) return;
+    uint32_t now = millis();
+    closeSegment(now);
+    inPass = false;
+
+    uint32_t passMs = now - passStartMs;
+    passes++;
+    if (passMs > maxPassMs) maxPassMs = passMs;
+
+    if (passMs > APP_LOOP_BUDGET_MS) {
+        overruns++;
+        slowest.passMs = passMs;
+        slowest.page = page ? page : "-";
+        if (passMs > worst.passMs) worst = slowest;
+
+        Serial.printf("LoopWatchdog: Pass took %lu ms (budget %u), %lu ms in %s%s%s on %s\n",
+                      (unsigned long)passMs, (unsigned)APP_LOOP_BUDGET_MS,
+                      (unsigned long)slowest.segmentMs, getStageName(slowest.stage),
+                      slowest.detail ? "/" : "", slowest.detail ? slowest.detail : "",
+                      slowest.page);
+    }
+}
+
+void LoopWatchdog::feedHardware() {
+#if APP_HW_WATCHDOG_MS > 0
+    // A clear while the previous one is still syncing would be ignored anyway
+    if (hardwareArmed && !WDT->SYNCBUSY.bit.CLEAR) {
+        WDT->CLEAR.reg = WDT_CLEAR_CLEAR_KEY;
+    }
+#endif
+}
+
+const char* LoopWatchdog::getStageName(LoopStage stage) {
+    return stage < LOOP_STAGE_COUNT ? stageNames[stage] : "?";
+}
+
+void LoopWatchdog::printStats() {
+    Serial.printf("LoopWatchdog: %lu passes, %lu over %u ms, longest %lu ms%s\n",
+                  (unsigned long)passes, (unsigned long)overruns, (unsigned)APP_LOOP_BUDGET_MS,
+                  (unsigned long)maxPassMs, hardwareArmed ? ", hardware armed" : "");
+    Serial.print("  stage max:");
+    for (uint8_t s = 0; s < LOOP_STAGE_COUNT; s++) {
+        Serial.printf(" %s %lu ms", stageNames[s], (unsigned long)stageMaxMs[s]);
+    }
+    Serial.println();
+    if (worst.passMs > 0) {
+        Serial.printf("  worst: %lu ms, %lu ms in %s%s%s on %s\n",
+                      (unsigned long)worst.passMs, (unsigned long)worst.segmentMs,
+                      getStageName(worst.stage), worst.detail ? "/" : "",
+                      worst.detail ? worst.detail : "", worst.page);
+    }
+}
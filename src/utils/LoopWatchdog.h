@@ -0,0 +1,79 @@
+#ifndef LOOP_WATCHDOG_H
+#define LOOP_WATCHDOG_H
+
+#include <Arduino.h>
+#include "../config/app_config.h"
+
+// Parts of one UI loop pass
+enum LoopStage : uint8_t {
+    LOOP_STAGE_TASKS = 0,   // Done callbacks of worker jobs, WiFi events
+    LOOP_STAGE_LVGL,        // LVGL timers, rendering and flushing
+    LOOP_STAGE_INPUT,       // Gesture and key handlers
+    LOOP_STAGE_SCHED,       // Scheduler jobs (page timers, periodic updates)
+    LOOP_STAGE_COUNT
+};
+
+// One slow loop pass
+struct LoopOverrun {
+    uint32_t passMs;
+    uint32_t segmentMs;     // Time of the slowest part of the pass
+    LoopStage stage;
+    const char* detail;     // Job name inside the stage, if known
+    const char* page;
+};
+
+// Heartbeat of the UI loop: measures every pass (without its sleep) and
+// flags those over APP_LOOP_BUDGET_MS, naming the page and the slowest
+// stage/job so blocking calls show up in the log instead of as a frozen UI.
+// With APP_HW_WATCHDOG_MS it also feeds the SAMD51 watchdog, which resets
+// the board if the loop stops passing.
+class LoopWatchdog {
+public:
+    static LoopWatchdog& getInstance();
+
+    // Arm the hardware watchdog (if configured) and report a watchdog reset
+    void begin();
+
+    // Around the work of one pass; endPass() also feeds the hardware watchdog
+    void beginPass();
+    void endPass(const char* page);
+
+    // The following time belongs to stage (and job detail, e.g. a scheduler job)
+    void mark(LoopStage stage, const char* detail = nullptr);
+
+    // Status
+    uint32_t getOverrunCount() const { return overruns; }
+    const LoopOverrun& getWorst() const { return worst; }
+    static const char* getStageName(LoopStage stage);
+    void printStats();
+
+private:
+    LoopWatchdog() = default;
+    ~LoopWatchdog() = default;
+    LoopWatchdog(const LoopWatchdog&) = delete;
+    LoopWatchdog& operator=(const LoopWatchdog&) = delete;
+
+    void closeSegment(uint32_t now);
+    void feedHardware();
+
+    // Current pass
+    bool inPass = false;
+    uint32_t passStartMs = 0;
+    uint32_t segmentStartMs = 0;
+    LoopStage stage = LOOP_STAGE_TASKS;
+    const char* detail = nullptr;
+    LoopOverrun slowest = {};       // Slowest segment of this pass
+
+    // Statistics
+    uint32_t passes = 0;
+    uint32_t overruns = 0;
+    uint32_t maxPassMs = 0;
+    uint32_t stageMaxMs[LOOP_STAGE_COUNT] = {};
+    LoopOverrun worst = {};
+    bool hardwareArmed = false;
+};
+
+// Global instance access
+#define LoopWdt LoopWatchdog::getInstance()
+
+#endif // LOOP_WATCHDOG_H
@@ -0,0 +1,112 @@
+#ifndef MAILBOX_H
+#define MAILBOX_H
+
+#include <Arduino.h>
+#include <atomic>
+
+// Counters of one mailbox
+struct MailboxStats {
+    uint32_t posted;
+    uint32_t dropped;     // post() found the mailbox full
+    uint32_t taken;
+    uint16_t depth;       // Messages waiting right now
+    uint16_t maxDepth;
+};
+
+// Fixed-capacity, lock-free message box from any number of producers
+// (worker tasks, interrupts) to one consumer (the UI loop). Each slot carries
+// a sequence number telling whose turn it is, so producers only contend on
+// one compare-and-swap and never block; a full mailbox drops the message
+// and counts it. Capacity must be a power of two.
+template <typename T, uint16_t Capacity>
+class Mailbox {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "Mailbox capacity must be a power of two");
+
+public:
+    Mailbox() {
+        for (uint16_t i = 0; i < Capacity; i++) {
+            slots[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    // Producer side: false (and counted) if full
+    bool post(const T& message) {
+        uint32_t pos = tail.load(std::memory_order_relaxed);
+        Slot* slot;
+        for (;;) {
+            slot = &slots[pos & (Capacity - 1)];
+            uint32_t seq = slot->seq.load(std::memory_order_acquire);
+            int32_t diff = (int32_t)(seq - pos);
+            if (diff == 0) {
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->data = message;
+        slot->seq.store(pos + 1, std::memory_order_release);
+        posted.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Consumer side: false if empty
+    bool take(T& message) {
+        Slot& slot = slots[head & (Capacity - 1)];
+        uint32_t seq = slot.seq.load(std::memory_order_acquire);
+        if ((int32_t)(seq - (head + 1)) < 0) return false;
+
+        uint16_t waiting = getDepth();
+        if (waiting > maxDepth) maxDepth = waiting;
+
+        message = slot.data;
+        slot.seq.store(head + Capacity, std::memory_order_release);
+        head++;
+        taken++;
+        return true;
+    }
+
+    // Messages posted but not yet taken (consumer side)
+    uint16_t getDepth() const {
+        return (uint16_t)(tail.load(std::memory_order_relaxed) - head);
+    }
+
+    MailboxStats getStats() const {
+        MailboxStats stats;
+        stats.posted = posted.load(std::memory_order_relaxed);
+        stats.dropped = dropped.load(std::memory_order_relaxed);
+        stats.taken = taken;
+        stats.depth = getDepth();
+        stats.maxDepth = maxDepth;
+        return stats;
+    }
+
+    void printStats(const char* name) const {
+        MailboxStats stats = getStats();
+        Serial.printf("Mailbox %s: %lu posted, %lu taken, %lu dropped, depth %u (max %u of %u)\n",
+                      name, (unsigned long)stats.posted, (unsigned long)stats.taken,
+                      (unsigned long)stats.dropped, (unsigned)stats.depth,
+                      (unsigned)stats.maxDepth, (unsigned)Capacity);
+    }
+
+private:
+    struct Slot {
+        std::atomic<uint32_t> seq;
+        T data;
+    };
+
+    Slot slots[Capacity];
+    std::atomic<uint32_t> tail{0};
+    uint32_t head = 0;                  // Only touched by the consumer
+
+    std::atomic<uint32_t> posted{0};
+    std::atomic<uint32_t> dropped{0};
+    uint32_t taken = 0;
+    uint16_t maxDepth = 0;
+};
+
+#endif // MAILBOX_H
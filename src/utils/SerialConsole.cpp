@@ -0,0 +1,81 @@
+#include "SerialConsole.h"
+#include "LoopWatchdog.h"
+
+SerialConsole& SerialConsole::getInstance() {
+    static SerialConsole instance;
+    return instance;
+}
+
+bool SerialConsole::add(const char* name, const char* help, ConsoleHandler handler) {
+    if (!name || !handler || commandCount >= CONSOLE_MAX_COMMANDS) {
+        Serial.printf("SerialConsole: Cannot add command %s\n", name ? name : "?");
+        return false;
+    }
+    commands[commandCount++] = { name, help ? help : "", handler };
+    return true;
+}
+
+void SerialConsole::poll() {
+    for (int budget = CONSOLE_READ_BUDGET; budget > 0 && Serial.available() > 0; budget--) {
+        int c = Serial.read();
+        if (c < 0) break;
+
+        if (c == '\r' || c == '\n') {
+            bool run = lineLen > 0 && !overflow;
+            if (overflow) {
+                Serial.printf("SerialConsole: Line longer than %d characters ignored\n", CONSOLE_LINE_LEN - 1);
+            }
+            line[lineLen] = '\0';
+            lineLen = 0;
+            overflow = false;
+
+            // One command per pass; the rest of the input waits for the next
+            if (run) {
+                execute(line);
+                return;
+            }
+        } else if (c == '\b' || c == 0x7F) {
+            if (lineLen > 0) lineLen--;
+        } else if (lineLen < CONSOLE_LINE_LEN - 1) {
+            line[lineLen++] = (char)c;
+        } else {
+            overflow = true;
+        }
+    }
+}
+
+void SerialConsole::execute(char* text) {
+    char* argv[CONSOLE_MAX_ARGS];
+    int argc = 0;
+
+    // Split on spaces in place
+    char* p = text;
+    while (*p && argc < CONSOLE_MAX_ARGS) {
+        while (*p == ' ' || *p == '\t') *p++ = '\0';
+        if (!*p) break;
+        argv[argc++] = p;
+        while (*p && *p != ' ' && *p != '\t') p++;
+    }
+    if (argc == 0) return;
+
+    if (strcmp(argv[0], "help") == 0 || strcmp(argv[0], "?") == 0) {
+        printHelp();
+        return;
+    }
+
+    for (uint8_t i = 0; i < commandCount; i++) {
+        if (strcmp(argv[0], commands[i].name) == 0) {
+            LoopWdt.mark(LOOP_STAGE_INPUT, commands[i].name);
+            commands[i].handler(argc, argv);
+            return;
+        }
+    }
+    Serial.printf("SerialConsole: Unknown command '%s' (try help)\n", argv[0]);
+}
+
+void SerialConsole::printHelp() {
+    Serial.println("Commands:");
+    for (uint8_t i = 0; i < commandCount; i++) {
+        Serial.printf("  %-8s %s\n", commands[i].name, commands[i].help);
+    }
+}
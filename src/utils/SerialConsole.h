@@ -0,0 +1,54 @@
+#ifndef SERIAL_CONSOLE_H
+#define SERIAL_CONSOLE_H
+
+#include <Arduino.h>
+
+#define CONSOLE_LINE_LEN        64      // Longer lines are rejected
+#define CONSOLE_MAX_COMMANDS    16
+#define CONSOLE_MAX_ARGS        4
+#define CONSOLE_READ_BUDGET     32      // Bytes taken from the serial port per poll()
+
+// argv[0] is the command name
+typedef void (*ConsoleHandler)(int argc, char** argv);
+
+struct ConsoleCommand {
+    const char* name;
+    const char* help;
+    ConsoleHandler handler;
+};
+
+// Line-based command console on the USB serial port. poll() takes what has
+// arrived so far (never waits for the rest of a line) and runs at most one
+// complete command per call, so typing never stalls the loop.
+class SerialConsole {
+public:
+    static SerialConsole& getInstance();
+
+    // Register a command; false if the table is full
+    bool add(const char* name, const char* help, ConsoleHandler handler);
+
+    // Read pending input and run a finished command (UI loop only)
+    void poll();
+
+    void printHelp();
+
+private:
+    SerialConsole() = default;
+    ~SerialConsole() = default;
+    SerialConsole(const SerialConsole&) = delete;
+    SerialConsole& operator=(const SerialConsole&) = delete;
+
+    void execute(char* text);
+
+    ConsoleCommand commands[CONSOLE_MAX_COMMANDS];
+    uint8_t commandCount = 0;
+
+    char line[CONSOLE_LINE_LEN];
+    uint8_t lineLen = 0;
+    bool overflow = false;      // Current line too long; dropped at its end
+};
+
+// Global instance access
+#define Console SerialConsole::getInstance()
+
+#endif // SERIAL_CONSOLE_H
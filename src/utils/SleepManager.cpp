@@ -0,0 +1,114 @@
+#include "SleepManager.h"
+
+SleepManager& SleepManager::getInstance() {
+    static SleepManager instance;
+    return instance;
+}
+
+#if defined(__SAMD51__)
+// Idle, not standby: the display DMA, SysTick (millis) and USB keep running
+static void selectIdleSleepMode() {
+    if (PM->SLEEPCFG.bit.SLEEPMODE != PM_SLEEPCFG_SLEEPMODE_IDLE_Val) {
+        PM->SLEEPCFG.reg = PM_SLEEPCFG_SLEEPMODE_IDLE;
+        while (PM->SLEEPCFG.bit.SLEEPMODE != PM_SLEEPCFG_SLEEPMODE_IDLE_Val) {}
+    }
+}
+#endif
+
+#if APP_IDLE_SLEEP && APP_USE_RTOS && defined(__SAMD51__)
+#if !configUSE_IDLE_HOOK
+#error "APP_IDLE_SLEEP with APP_USE_RTOS needs configUSE_IDLE_HOOK in FreeRTOSConfig.h"
+#endif
+
+// With FreeRTOS the UI task blocks instead of sleeping itself; the core is
+// put to sleep here, whenever no task is ready, until the next interrupt.
+// The tick is not suppressed (no tickless idle), so SysTick still wakes the
+// core every tick. Replaces the library's weak default, which runs the
+// Arduino loop() from the idle task.
+extern "C" void vApplicationIdleHook(void) {
+    selectIdleSleepMode();
+    __DSB();
+    __WFI();
+}
+#endif
+
+void SleepManager::sleep(uint32_t ms) {
+    uint32_t start = millis();
+    stats.passes++;
+    if (ms == 0) {
+        wakePending = false;
+        return;
+    }
+
+#if !APP_IDLE_SLEEP
+#if APP_USE_RTOS
+    vTaskDelay(pdMS_TO_TICKS(ms));
+#else
+    delay(ms);
+#endif
+#elif APP_USE_RTOS
+    uiTask = xTaskGetCurrentTaskHandle();
+    wakePending = false;
+    if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(ms)) > 0) {
+        stats.earlyWakes++;
+    }
+#else
+#if defined(__SAMD51__)
+    selectIdleSleepMode();
+#endif
+    // A wake() landing between the check and WFI is picked up by the next
+    // SysTick, at most 1 ms later
+    while (millis() - start < ms) {
+        if (wakePending) {
+            stats.earlyWakes++;
+            break;
+        }
+#if defined(__SAMD51__)
+        __DSB();
+        __WFI();
+#else
+        yield();
+#endif
+    }
+    wakePending = false;
+#endif
+
+    stats.sleptMs += millis() - start;
+}
+
+// From an interrupt this must run at SLEEP_WAKE_IRQ_PRIORITY or a lower
+// urgency (numerically >=): vTaskNotifyGiveFromISR from a higher-priority
+// ISR can corrupt the kernel's lists. The Arduino core puts the EIC at 0, so
+// InputManager::begin() lowers the key lines.
+void SleepManager::wake() {
+    wakePending = true;
+
+#if APP_IDLE_SLEEP && APP_USE_RTOS
+    TaskHandle_t task = uiTask;
+    if (!task || xTaskGetSchedulerState() != taskSCHEDULER_RUNNING) return;
+
+    if (__get_IPSR() != 0) {
+        BaseType_t woken = pdFALSE;
+        vTaskNotifyGiveFromISR(task, &woken);
+        portYIELD_FROM_ISR(woken);
+    } else if (task != xTaskGetCurrentTaskHandle()) {
+        xTaskNotifyGive(task);
+    }
+#endif
+}
+
+void SleepManager::printStats() {
+    uint32_t now = millis();
+    uint32_t window = now - windowStart;
+    if (window == 0) window = 1;
+
+    Serial.printf("SleepManager: %lu.%lu wakeups/s (%lu early), idle %lu%%, %s\n",
+                  (unsigned long)(stats.passes * 1000UL / window),
+                  (unsigned long)(stats.passes * 10000UL / window % 10),
+                  (unsigned long)stats.earlyWakes,
+                  (unsigned long)(stats.sleptMs * 100UL / window),
+                  APP_IDLE_SLEEP ? "WFI sleep" : "delay() polling");
+
+    stats = {};
+    windowStart = now;
+}
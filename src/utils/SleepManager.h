@@ -0,0 +1,64 @@
+#ifndef SLEEP_MANAGER_H
+#define SLEEP_MANAGER_H
+
+#include <Arduino.h>
+#include "../config/app_config.h"
+
+#if APP_USE_RTOS
+#include <Seeed_Arduino_FreeRTOS.h>
+#endif
+
+// NVIC priority (numeric, 0 = most urgent) an interrupt needs to call
+// wake(): with APP_USE_RTOS it makes FreeRTOS FromISR calls, which are only
+// allowed at or below configMAX_SYSCALL_INTERRUPT_PRIORITY
+#if APP_USE_RTOS && defined(__SAMD51__)
+#define SLEEP_WAKE_IRQ_PRIORITY (configMAX_SYSCALL_INTERRUPT_PRIORITY >> (8 - __NVIC_PRIO_BITS))
+#endif
+
+// Loop wake-up counters, reset by printStats()
+struct SleepStats {
+    uint32_t passes;      // Loop passes (one sleep each)
+    uint32_t earlyWakes;  // Sleeps ended by wake() before their deadline
+    uint32_t sleptMs;
+};
+
+// Puts the UI loop to sleep until its next deadline. Without APP_USE_RTOS
+// the core waits in WFI (idle mode; SysTick, the key interrupts and DMA
+// still run), with it the UI task blocks on a task notification and the
+// FreeRTOS idle hook does the WFI. Either
+// way wake() ends the sleep early, so a key press or a worker result is
+// handled at once instead of at the next poll. With APP_IDLE_SLEEP=0 it
+// falls back to a plain delay and only counts the wake-ups.
+class SleepManager {
+public:
+    static SleepManager& getInstance();
+
+    // Sleep the UI loop for up to ms (UI loop only)
+    void sleep(uint32_t ms);
+
+    // End the current or next sleep early (any task, or an interrupt at
+    // SLEEP_WAKE_IRQ_PRIORITY or lower)
+    void wake();
+
+    // Status
+    void printStats();
+
+private:
+    SleepManager() = default;
+    ~SleepManager() = default;
+    SleepManager(const SleepManager&) = delete;
+    SleepManager& operator=(const SleepManager&) = delete;
+
+    volatile bool wakePending = false;
+#if APP_USE_RTOS
+    volatile TaskHandle_t uiTask = nullptr;
+#endif
+
+    SleepStats stats = {};
+    uint32_t windowStart = 0;
+};
+
+// Global instance access
+#define SleepMgr SleepManager::getInstance()
+
+#endif // SLEEP_MANAGER_H
@@ -0,0 +1,386 @@
+#include "SnapshotCache.h"
+
+#if DISP_PAGE_SNAPSHOT
+
+#if LV_COLOR_DEPTH != 16
+#error "SnapshotCache encodes 16-bit pixels"
+#endif
+
+// Picture layout: header, one word offset per row, then the rows. Each row
+// is a sequence of tokens: a control word with SNAPSHOT_RUN set is followed
+// by one pixel repeated (control & SNAPSHOT_COUNT) times, otherwise by that
+// many literal pixels. Tokens never cross rows, so any row can be decoded
+// on its own.
+#define SNAPSHOT_MAGIC          0x50414E53  // "SNAP"
+#define SNAPSHOT_RUN            0x8000
+#define SNAPSHOT_COUNT          0x7FFF
+#define SNAPSHOT_MIN_RUN        3           // Shorter repeats stay in literals
+
+struct SnapshotHeader {
+    uint32_t magic;
+    uint16_t w;
+    uint16_t h;
+};
+
+static const SnapshotHeader* getHeader(const void* src) {
+    if (lv_img_src_get_type(src) != LV_IMG_SRC_VARIABLE) return nullptr;
+
+    const lv_img_dsc_t* img = (const lv_img_dsc_t*)src;
+    if (img->header.cf != LV_IMG_CF_USER_ENCODED_0 || img->data_size < sizeof(SnapshotHeader)) return nullptr;
+
+    const SnapshotHeader* header = (const SnapshotHeader*)img->data;
+    return header->magic == SNAPSHOT_MAGIC ? header : nullptr;
+}
+
+static lv_res_t decoderInfo(lv_img_decoder_t* decoder, const void* src, lv_img_header_t* header) {
+    (void)decoder;
+    const SnapshotHeader* snapshot = getHeader(src);
+    if (!snapshot) return LV_RES_INV;
+
+    header->cf = LV_IMG_CF_USER_ENCODED_0;  // Drawn as opaque true color
+    header->always_zero = 0;
+    header->w = snapshot->w;
+    header->h = snapshot->h;
+    return LV_RES_OK;
+}
+
+static lv_res_t decoderOpen(lv_img_decoder_t* decoder, lv_img_decoder_dsc_t* dsc) {
+    (void)decoder;
+    const SnapshotHeader* snapshot = getHeader(dsc->src);
+    if (!snapshot) return LV_RES_INV;
+
+    // No decoded copy: LVGL asks for each line through decoderReadLine
+    dsc->img_data = nullptr;
+    dsc->user_data = (void*)snapshot;
+    return LV_RES_OK;
+}
+
+static lv_res_t decoderReadLine(lv_img_decoder_t* decoder, lv_img_decoder_dsc_t* dsc,
+                                lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t* buf) {
+    (void)decoder;
+    const SnapshotHeader* snapshot = (const SnapshotHeader*)dsc->user_data;
+    if (!snapshot || y < 0 || y >= snapshot->h) return LV_RES_INV;
+
+    const uint32_t* rows = (const uint32_t*)(snapshot + 1);
+    const uint16_t* in = (const uint16_t*)(rows + snapshot->h) + rows[y];
+    uint16_t* out = (uint16_t*)buf - x;
+    lv_coord_t end = x + len;
+
+    for (lv_coord_t pos = 0; pos < end;) {
+        uint16_t control = *in++;
+        lv_coord_t count = control & SNAPSHOT_COUNT;
+        lv_coord_t from = LV_MAX(pos, x);
+        lv_coord_t to = LV_MIN(pos + count, end);
+
+        if (control & SNAPSHOT_RUN) {
+            for (lv_coord_t i = from; i < to; i++) out[i] = *in;
+            in++;
+        } else {
+            for (lv_coord_t i = from; i < to; i++) out[i] = in[i - pos];
+            in += count;
+        }
+        pos += count;
+    }
+    return LV_RES_OK;
+}
+
+static void decoderClose(lv_img_decoder_t* decoder, lv_img_decoder_dsc_t* dsc) {
+    (void)decoder;
+    dsc->user_data = nullptr;
+}
+
+static void registerDecoder() {
+    static bool registered = false;
+    if (registered) return;
+
+    lv_img_decoder_t* decoder = lv_img_decoder_create();
+    lv_img_decoder_set_info_cb(decoder, decoderInfo);
+    lv_img_decoder_set_open_cb(decoder, decoderOpen);
+    lv_img_decoder_set_read_line_cb(decoder, decoderReadLine);
+    lv_img_decoder_set_close_cb(decoder, decoderClose);
+    registered = true;
+}
+
+// Encode one row; returns the words written (or, with out == nullptr, the
+// words it would take), 0 when room ran out
+static uint32_t encodeRow(const uint16_t* px, lv_coord_t w, uint16_t* out, uint32_t room) {
+    uint32_t n = 0;
+    lv_coord_t i = 0;
+
+    while (i < w) {
+        lv_coord_t run = 1;
+        while (i + run < w && run < SNAPSHOT_COUNT && px[i + run] == px[i]) run++;
+
+        if (run >= SNAPSHOT_MIN_RUN) {
+            if (n + 2 > room) return 0;
+            if (out) {
+                out[n] = SNAPSHOT_RUN | run;
+                out[n + 1] = px[i];
+            }
+            n += 2;
+            i += run;
+            continue;
+        }
+
+        // Literals up to the next run worth encoding
+        lv_coord_t start = i;
+        while (i < w && i - start < SNAPSHOT_COUNT) {
+            if (i + SNAPSHOT_MIN_RUN <= w && px[i] == px[i + 1] && px[i] == px[i + 2]) break;
+            i++;
+        }
+        lv_coord_t count = i - start;
+        if (n + 1 + count > room) return 0;
+        if (out) {
+            out[n] = count;
+            memcpy(out + n + 1, px + start, count * sizeof(uint16_t));
+        }
+        n += 1 + count;
+    }
+    return n;
+}
+
+SnapshotCache::~SnapshotCache() {
+    clear();
+}
+
+bool SnapshotCache::capture(const void* key, lv_obj_t* obj) {
+    if (!obj || budget == 0) return false;
+    registerDecoder();
+
+    uint32_t startUs = micros();
+
+    lv_obj_update_layout(obj);
+    lv_area_t coords;
+    lv_obj_get_coords(obj, &coords);
+    lv_coord_t w = lv_area_get_width(&coords);
+    lv_coord_t h = lv_area_get_height(&coords);
+    if (w <= 0 || h <= 0 || w > 2047 || h > 2047) return false;  // 11-bit image header
+
+    // The old picture is replaced either way
+    drop(key);
+
+    // Everything a capture allocates on the heap counts against the budget,
+    // so evict before allocating: the budget bounds the peak, not just the
+    // pictures kept afterwards
+    uint32_t stripBytes = w * DISP_SNAPSHOT_LINES * sizeof(lv_color_t);
+    if (!makeRoom(stripBytes)) return false;
+
+    lv_color_t* strip = (lv_color_t*)malloc(stripBytes);
+    lv_disp_t* disp = lv_obj_get_disp(obj);
+    lv_draw_ctx_t* drawCtx = (lv_draw_ctx_t*)lv_mem_alloc(disp->driver->draw_ctx_size);
+    if (!strip || !drawCtx) {
+        Serial.println("SnapshotCache: Out of memory");
+        free(strip);
+        if (drawCtx) lv_mem_free(drawCtx);
+        return false;
+    }
+    used += stripBytes;
+
+    // Render into the strip the way lv_snapshot renders into a full buffer:
+    // a throwaway display whose draw context covers only the strip
+    lv_disp_drv_t driver;
+    lv_disp_drv_init(&driver);
+    driver.hor_res = lv_disp_get_hor_res(disp);
+    driver.ver_res = lv_disp_get_ver_res(disp);
+    lv_disp_drv_use_generic_set_px_cb(&driver, LV_IMG_CF_TRUE_COLOR);
+
+    lv_disp_t fakeDisp;
+    memset(&fakeDisp, 0, sizeof(fakeDisp));
+    fakeDisp.driver = &driver;
+
+    lv_area_t stripArea = coords;
+    disp->driver->draw_ctx_init(&driver, drawCtx);
+    driver.draw_ctx = drawCtx;
+    drawCtx->buf = strip;
+    drawCtx->buf_area = &stripArea;
+    drawCtx->clip_area = &stripArea;
+
+    lv_disp_t* refreshing = _lv_refr_get_disp_refreshing();
+    _lv_refr_set_disp_refreshing(&fakeDisp);
+
+    // Two passes: the first only measures, so the picture gets a buffer of
+    // its exact size and no more is evicted than it takes. Pictures are
+    // taken while the UI idles, where the second render costs nothing.
+    uint32_t headerBytes = sizeof(SnapshotHeader) + h * sizeof(uint32_t);
+    uint32_t limit = (uint32_t)DISP_SNAPSHOT_MAX_BYTES;
+    uint32_t room = limit > headerBytes ? (limit - headerBytes) / sizeof(uint16_t) : 0;
+    uint8_t* data = nullptr;
+    uint32_t* rows = nullptr;
+    uint16_t* words = nullptr;
+    uint32_t n = 0;
+    bool fits = room > 0;
+
+    for (int pass = 0; pass < 2 && fits; pass++) {
+        if (pass == 1) {
+            room = n;
+            uint32_t size = headerBytes + n * sizeof(uint16_t);
+            fits = makeRoom(size) && (data = (uint8_t*)malloc(size)) != nullptr;
+            if (!fits) break;
+
+            SnapshotHeader* header = (SnapshotHeader*)data;
+            header->magic = SNAPSHOT_MAGIC;
+            header->w = w;
+            header->h = h;
+            rows = (uint32_t*)(header + 1);
+            words = (uint16_t*)(rows + h);
+        }
+        n = 0;
+
+        for (lv_coord_t y = 0; y < h && fits; y += DISP_SNAPSHOT_LINES) {
+            lv_coord_t lines = LV_MIN(DISP_SNAPSHOT_LINES, h - y);
+            stripArea.y1 = coords.y1 + y;
+            stripArea.y2 = stripArea.y1 + lines - 1;
+            memset(strip, 0, w * lines * sizeof(lv_color_t));
+            lv_obj_redraw(drawCtx, obj);
+
+            for (lv_coord_t line = 0; line < lines; line++) {
+                if (rows) rows[y + line] = n;
+                uint32_t written = encodeRow((const uint16_t*)(strip + line * w), w,
+                                             words ? words + n : nullptr, room - n);
+                if (written == 0) {
+                    fits = false;
+                    break;
+                }
+                n += written;
+            }
+        }
+    }
+
+    _lv_refr_set_disp_refreshing(refreshing);
+    disp->driver->draw_ctx_deinit(&driver, drawCtx);
+    lv_mem_free(drawCtx);
+    free(strip);
+    used -= stripBytes;
+
+    if (!fits) {
+        if (data) {
+            Serial.println("SnapshotCache: Page changed while captured");
+            free(data);
+        } else {
+            tooLarge++;
+        }
+        return false;
+    }
+
+    // A free slot, else the least recently used one
+    Entry* entry = find(nullptr);
+    if (!entry) {
+        entry = &entries[0];
+        for (Entry& candidate : entries) {
+            if (candidate.lastUse < entry->lastUse) entry = &candidate;
+        }
+        evictions++;
+    }
+    release(*entry);
+
+    uint32_t size = headerBytes + n * sizeof(uint16_t);
+    entry->key = key;
+    entry->data = data;
+    entry->size = size;
+    entry->lastUse = ++useClock;
+    entry->dsc.header.cf = LV_IMG_CF_USER_ENCODED_0;
+    entry->dsc.header.always_zero = 0;
+    entry->dsc.header.w = w;
+    entry->dsc.header.h = h;
+    entry->dsc.data_size = size;
+    entry->dsc.data = data;
+    used += size;
+
+    uint32_t elapsedUs = micros() - startUs;
+    captures++;
+    captureUsTotal += elapsedUs;
+    if (elapsedUs > captureUsMax) captureUsMax = elapsedUs;
+    return true;
+}
+
+const lv_img_dsc_t* SnapshotCache::get(const void* key) {
+    Entry* entry = key ? find(key) : nullptr;
+    if (!entry) {
+        misses++;
+        return nullptr;
+    }
+    hits++;
+    entry->lastUse = ++useClock;
+    return &entry->dsc;
+}
+
+void SnapshotCache::drop(const void* key) {
+    Entry* entry = key ? find(key) : nullptr;
+    if (entry) release(*entry);
+}
+
+void SnapshotCache::clear() {
+    for (Entry& entry : entries) {
+        release(entry);
+    }
+}
+
+void SnapshotCache::setBudget(uint32_t bytes) {
+    budget = bytes;
+    evictToFit(nullptr);
+}
+
+SnapshotCache::Entry* SnapshotCache::find(const void* key) {
+    for (Entry& entry : entries) {
+        if (entry.key == key) return &entry;
+    }
+    return nullptr;
+}
+
+void SnapshotCache::release(Entry& entry) {
+    if (entry.data) {
+        lv_img_cache_invalidate_src(&entry.dsc);
+        free(entry.data);
+        used -= entry.size;
+    }
+    entry = {};
+}
+
+bool SnapshotCache::makeRoom(uint32_t bytes) {
+    if (bytes > budget) return false;
+
+    while (used + bytes > budget) {
+        Entry* oldest = nullptr;
+        for (Entry& entry : entries) {
+            if (!entry.data) continue;
+            if (!oldest || entry.lastUse < oldest->lastUse) oldest = &entry;
+        }
+        if (!oldest) return false;
+        release(*oldest);
+        evictions++;
+    }
+    return true;
+}
+
+void SnapshotCache::evictToFit(const Entry* keep) {
+    while (used > budget) {
+        Entry* oldest = nullptr;
+        for (Entry& entry : entries) {
+            if (!entry.data || &entry == keep) continue;
+            if (!oldest || entry.lastUse < oldest->lastUse) oldest = &entry;
+        }
+        if (!oldest) {
+            // Only the kept picture is left and it alone is over the budget
+            if (keep) release(*(Entry*)keep);
+            return;
+        }
+        release(*oldest);
+        evictions++;
+    }
+}
+
+void SnapshotCache::printStats() {
+    uint8_t pictures = 0;
+    for (const Entry& entry : entries) {
+        if (entry.data) pictures++;
+    }
+    Serial.printf("SnapshotCache: %u pictures, %lu of %lu bytes, %lu hits, %lu misses, %lu evicted, %lu too large\n",
+                  pictures, (unsigned long)used, (unsigned long)budget,
+                  (unsigned long)hits, (unsigned long)misses,
+                  (unsigned long)evictions, (unsigned long)tooLarge);
+    Serial.printf("SnapshotCache: capture avg %lu us, max %lu us (%lu captures)\n",
+                  (unsigned long)(captures ? captureUsTotal / captures : 0),
+                  (unsigned long)captureUsMax, (unsigned long)captures);
+}
+
+#endif // DISP_PAGE_SNAPSHOT
@@ -0,0 +1,70 @@
+#ifndef SNAPSHOT_CACHE_H
+#define SNAPSHOT_CACHE_H
+
+#include <Arduino.h>
+#include "lvgl.h"
+#include "../config/display_config.h"
+
+#define SNAPSHOT_MAX_ENTRIES    10
+
+// Keeps pictures of whole objects (page roots) within a heap budget and
+// evicts the least recently used one when a new picture does not fit. The
+// budget also covers the buffers a capture works in, so it bounds the peak.
+// Pictures are rendered strip by strip, so capturing never needs a
+// full-frame buffer, and stored run-length encoded per row: flat page
+// backgrounds cost a few bytes per row. An image decoder expands them one
+// line at a time while LVGL draws, so they can be shown with lv_img.
+class SnapshotCache {
+public:
+    SnapshotCache() = default;
+    ~SnapshotCache();
+
+    // Render obj as it looks now and store it under key (replacing the old picture)
+    bool capture(const void* key, lv_obj_t* obj);
+
+    // Picture for key (an lv_img source), nullptr if none; counts as a use
+    const lv_img_dsc_t* get(const void* key);
+
+    void drop(const void* key);
+    void clear();
+
+    // Heap bytes all pictures may use together; shrinking evicts at once
+    void setBudget(uint32_t bytes);
+    uint32_t getBudget() const { return budget; }
+    uint32_t getUsedBytes() const { return used; }
+
+    void printStats();
+
+private:
+    SnapshotCache(const SnapshotCache&) = delete;
+    SnapshotCache& operator=(const SnapshotCache&) = delete;
+
+    struct Entry {
+        const void* key;
+        uint8_t* data;
+        uint32_t size;
+        uint32_t lastUse;
+        lv_img_dsc_t dsc;       // Points into data; what lv_img shows
+    };
+
+    Entry* find(const void* key);
+    void release(Entry& entry);
+    // Evict until bytes more fit in the budget
+    bool makeRoom(uint32_t bytes);
+    void evictToFit(const Entry* keep);
+
+    Entry entries[SNAPSHOT_MAX_ENTRIES] = {};
+    uint32_t budget = DISP_SNAPSHOT_BUDGET;
+    uint32_t used = 0;
+    uint32_t useClock = 0;
+
+    uint32_t captures = 0;
+    uint32_t tooLarge = 0;      // Captures that did not fit DISP_SNAPSHOT_MAX_BYTES
+    uint32_t hits = 0;
+    uint32_t misses = 0;
+    uint32_t evictions = 0;
+    uint32_t captureUsTotal = 0;
+    uint32_t captureUsMax = 0;
+};
+
+#endif // SNAPSHOT_CACHE_H
@@ -1,5 +1,6 @@
 #include "WiFiManager.h"
 #include "../config/wifi_config.h"
+#include "SleepManager.h"
 
 WiFiManager& WiFiManager::getInstance() {
     static WiFiManager instance;
@@ -34,6 +35,7 @@ bool WiFiManager::begin() {
     hasValidCredentials = true;
     savedSSID = "SimulatedWiFi";
     savedPassword = "password";
+    postEvent(WIFI_LINK_UP);
 #endif
 
     return true;
@@ -44,6 +46,7 @@ bool WiFiManager::connect(const String& ssid, const String& password) {
     if (!initialized) begin();
     
     Serial.printf("WiFiManager: Connecting to %s...\n", ssid.c_str());
+    postEvent(WIFI_LINK_CONNECTING);
     
     WiFi.begin(ssid.c_str(), password.c_str());
     
@@ -59,14 +62,17 @@ bool WiFiManager::connect(const String& ssid, const String& password) {
         Serial.println();
         Serial.printf("WiFiManager: Connected! IP: %s\n", WiFi.localIP().toString().c_str());
         saveCredentials(ssid, password);
+        postEvent(WIFI_LINK_UP);
         return true;
     } else {
         Serial.println();
         Serial.println("WiFiManager: Connection failed");
+        postEvent(WIFI_LINK_DOWN);
         return false;
     }
 #else
     Serial.printf("WiFiManager: Simulated connection to %s\n", ssid.c_str());
+    postEvent(WIFI_LINK_UP);
     return true;
 #endif
 }
@@ -90,6 +96,7 @@ void WiFiManager::disconnect() {
 #else
     Serial.println("WiFiManager: Simulated disconnect");
 #endif
+    postEvent(WIFI_LINK_DOWN);
 }
 
 bool WiFiManager::isConnected() {
@@ -226,6 +233,22 @@ bool WiFiManager::isInitialized() {
     return initialized;
 }
 
+void WiFiManager::postEvent(WiFiLinkState state) {
+    WiFiLinkEvent event = {};
+    event.state = state;
+    if (state == WIFI_LINK_UP) {
+        event.rssi = (int8_t)getSignalStrength();
+        strncpy(event.ip, getLocalIP().c_str(), sizeof(event.ip) - 1);
+    }
+
+    // Only the latest state matters to the UI; a full mailbox is counted
+    if (!events.post(event)) {
+        Serial.println("WiFiManager: Event mailbox full");
+        return;
+    }
+    SleepMgr.wake();
+}
+
 void WiFiManager::loadCredentialsFromConfig() {
     // Load WiFi credentials from config file
     savedSSID = WIFI_SSID;
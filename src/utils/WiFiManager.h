@@ -2,6 +2,7 @@
 #define WIFI_MANAGER_H
 
 #include <Arduino.h>
+#include "Mailbox.h"
 
 #ifndef SIMULATOR_BUILD
 #include <WiFi.h>
@@ -9,6 +10,21 @@
 // We'll use simple variables for now
 #endif
 
+#define WIFI_EVENT_DEPTH 4      // Link changes waiting for the UI loop
+
+enum WiFiLinkState : uint8_t {
+    WIFI_LINK_DOWN = 0,
+    WIFI_LINK_CONNECTING,
+    WIFI_LINK_UP
+};
+
+// Link change, posted by whichever task made the WiFi call
+struct WiFiLinkEvent {
+    WiFiLinkState state;
+    int8_t rssi;
+    char ip[16];
+};
+
 class WiFiManager {
 public:
     static WiFiManager& getInstance();
@@ -38,6 +54,10 @@ public:
     bool isScanning();
     bool isInitialized();
 
+    // Link changes for the UI loop (consumer side only)
+    bool takeEvent(WiFiLinkEvent& event) { return events.take(event); }
+    void printEventStats() const { events.printStats("wifi"); }
+
 private:
     WiFiManager() = default;
     ~WiFiManager() = default;
@@ -53,8 +73,13 @@ private:
     bool initialized = false;
     bool scanning = false;
     unsigned long lastScanTime = 0;
+
+    // The connect calls may run on the network task, so link changes reach
+    // the UI through a mailbox instead of touching LVGL here
+    Mailbox<WiFiLinkEvent, WIFI_EVENT_DEPTH> events;
     
     // Helper functions
+    void postEvent(WiFiLinkState state);
     void initializeWiFi();
     void handleWiFiEvent();
     void loadCredentialsFromConfig();
@@ -0,0 +1,56 @@
+#ifndef COLOR_UTILS_H
+#define COLOR_UTILS_H
+
+#include <stdint.h>
+
+// Word view of a pixel buffer (exempt from strict aliasing)
+typedef uint32_t __attribute__((may_alias)) rgb565_word_t;
+
+// Byte swap of two packed RGB565 pixels in one 32-bit word
+static inline uint32_t rgb565_swap2(uint32_t v) {
+#if defined(__ARM_ARCH) && (__ARM_ARCH >= 6)
+    uint32_t r;
+    __asm__("rev16 %0, %1" : "=r"(r) : "r"(v));
+    return r;
+#else
+    return ((v & 0x00FF00FFu) << 8) | ((v >> 8) & 0x00FF00FFu);
+#endif
+}
+
+static inline uint16_t rgb565_swap(uint16_t c) {
+    return (uint16_t)((c << 8) | (c >> 8));
+}
+
+// Swap the bytes of count RGB565 pixels from src into dst (may be the same buffer).
+// Works a 32-bit word (two pixels) at a time, unrolled by four words.
+static inline void rgb565_swap_buf(uint16_t* dst, const uint16_t* src, uint32_t count) {
+    // Word access needs both pointers on the same 4-byte phase
+    if ((((uintptr_t)dst ^ (uintptr_t)src) & 3u) != 0) {
+        while (count--) *dst++ = rgb565_swap(*src++);
+        return;
+    }
+    if (((uintptr_t)src & 3u) != 0 && count) {
+        *dst++ = rgb565_swap(*src++);
+        count--;
+    }
+
+    rgb565_word_t* d = (rgb565_word_t*)dst;
+    const rgb565_word_t* s = (const rgb565_word_t*)src;
+    uint32_t words = count >> 1;
+    while (words >= 4) {
+        d[0] = rgb565_swap2(s[0]);
+        d[1] = rgb565_swap2(s[1]);
+        d[2] = rgb565_swap2(s[2]);
+        d[3] = rgb565_swap2(s[3]);
+        d += 4;
+        s += 4;
+        words -= 4;
+    }
+    while (words--) *d++ = rgb565_swap2(*s++);
+
+    if (count & 1u) {
+        *(uint16_t*)d = rgb565_swap(*(const uint16_t*)s);
+    }
+}
+
+#endif // COLOR_UTILS_H
@@ -0,0 +1,45 @@
+#pragma once
+
+// Minimal Arduino API for the native unit tests (pio test -e native).
+// millis() is a clock the tests move themselves, so scheduler and gesture
+// timing is exact; micros() is real time, for benchmarks.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+
+inline uint32_t nativeMillis = 0;
+
+inline unsigned long millis() {
+    return nativeMillis;
+}
+
+inline unsigned long micros() {
+    using namespace std::chrono;
+    return (unsigned long)duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+inline void delay(unsigned long ms) {
+    nativeMillis += ms;
+}
+
+// Serial output goes to stdout
+class NativeSerial {
+public:
+    void begin(unsigned long) {}
+    size_t print(const char* s) { return (size_t)::printf("%s", s); }
+    size_t println(const char* s = "") { return (size_t)::printf("%s\n", s); }
+
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3))) {
+        va_list args;
+        va_start(args, format);
+        int n = vprintf(format, args);
+        va_end(args);
+        return n > 0 ? (size_t)n : 0;
+    }
+};
+
+inline NativeSerial Serial;
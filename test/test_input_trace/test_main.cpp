@@ -0,0 +1,212 @@
+// Input record/replay (utils/InputTrace): a scripted key session is fed
+// through the same path as main.cpp's handleInputEvent (recorder, then
+// gesture engine), saved to a host file, loaded back and replayed through
+// handleReplayEvent's path. The replay must produce the same gestures.
+
+#include <Arduino.h>
+#include <unity.h>
+#include <vector>
+#include "utils/InputTrace.h"
+
+#define TRACE_FILE "test_input_trace.bin"
+
+struct ScriptEvent {
+    uint32_t atMs;
+    InputKey key;
+    bool pressed;
+};
+
+// Press, double tap, auto-repeat, long press, chord, and a press after a
+// gap too long for one record
+static const ScriptEvent session[] = {
+    { 1000, INPUT_UP, true },     { 1080, INPUT_UP, false },
+    { 2000, INPUT_PRESS, true },  { 2050, INPUT_PRESS, false },
+    { 2150, INPUT_PRESS, true },  { 2200, INPUT_PRESS, false },
+    { 3000, INPUT_DOWN, true },   { 4000, INPUT_DOWN, false },
+    { 5000, INPUT_KEY_C, true },  { 5800, INPUT_KEY_C, false },
+    { 7000, INPUT_KEY_A, true },  { 7020, INPUT_KEY_B, true },
+    { 7200, INPUT_KEY_A, false }, { 7210, INPUT_KEY_B, false },
+    { 80000, INPUT_UP, true },    { 80060, INPUT_UP, false },
+};
+#define SESSION_EVENTS (sizeof(session) / sizeof(session[0]))
+#define SESSION_END_MS 81000
+
+static const GestureConfig gestureConfig = {
+    GESTURE_KEY(INPUT_DOWN),                    // repeatKeys
+    GESTURE_KEY(INPUT_KEY_C),                   // longPressKeys
+    GESTURE_KEY(INPUT_PRESS),                   // doubleTapKeys
+    { (uint8_t)(GESTURE_KEY(INPUT_KEY_A) | GESTURE_KEY(INPUT_KEY_B)), 0 }
+};
+
+static std::vector<Gesture> gestures;
+static std::vector<InputEvent> replayed;
+static bool replayDone;
+
+static void onGesture(const Gesture& gesture) {
+    gestures.push_back(gesture);
+}
+
+// As handleInputEvent / handleReplayEvent in main.cpp
+static void handleInputEvent(const InputEvent& event) {
+    InputTrc.record(event);
+    Gestures.onInput(event);
+}
+
+static void handleReplayEvent(const InputEvent& event) {
+    replayed.push_back(event);
+    Gestures.onInput(event);
+}
+
+static void onReplayDone() {
+    replayDone = true;
+}
+
+// Move the clock 1 ms at a time, running due scheduler jobs like the loop
+static void runUntil(uint32_t endMs) {
+    while ((int32_t)(millis() - endMs) < 0) {
+        nativeMillis++;
+        Sched.run();
+    }
+}
+
+static uint32_t recordSession() {
+    uint32_t startMs = millis();
+    uint16_t seq = 0;
+
+    InputTrc.startRecording();
+    for (size_t i = 0; i < SESSION_EVENTS; i++) {
+        runUntil(startMs + session[i].atMs);
+        InputEvent event = { session[i].key, session[i].pressed, ++seq, (uint32_t)millis() };
+        handleInputEvent(event);
+    }
+    runUntil(startMs + SESSION_END_MS);
+    InputTrc.stopRecording();
+    return startMs;
+}
+
+static void assertSameGestures(const std::vector<Gesture>& expected, const std::vector<Gesture>& actual) {
+    TEST_ASSERT_EQUAL(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        TEST_ASSERT_EQUAL(expected[i].type, actual[i].type);
+        TEST_ASSERT_EQUAL(expected[i].key, actual[i].key);
+        TEST_ASSERT_EQUAL(expected[i].key2, actual[i].key2);
+        TEST_ASSERT_EQUAL(expected[i].count, actual[i].count);
+    }
+}
+
+static uint32_t countType(const std::vector<Gesture>& list, GestureType type) {
+    uint32_t n = 0;
+    for (const Gesture& g : list) {
+        if (g.type == type) n++;
+    }
+    return n;
+}
+
+void setUp() {
+    gestures.clear();
+    replayed.clear();
+    replayDone = false;
+    Gestures.setHandler(onGesture);
+    Gestures.setConfig(&gestureConfig);
+}
+
+void tearDown() {
+    InputTrc.stopReplay();
+    remove(TRACE_FILE);
+}
+
+static void test_recorded_session_gestures() {
+    recordSession();
+
+    // The script itself must give every gesture kind, or the replay
+    // comparison below proves little
+    TEST_ASSERT_EQUAL(3, countType(gestures, GESTURE_PRESS));   // UP twice, DOWN
+    TEST_ASSERT_EQUAL(1, countType(gestures, GESTURE_DOUBLE_TAP));
+    TEST_ASSERT_TRUE(countType(gestures, GESTURE_REPEAT) >= 3);
+    TEST_ASSERT_EQUAL(1, countType(gestures, GESTURE_LONG_PRESS));
+    TEST_ASSERT_EQUAL(1, countType(gestures, GESTURE_CHORD));
+
+    // Wait records for the 72 s gap
+    TEST_ASSERT_EQUAL(SESSION_EVENTS + 1, InputTrc.getCount());
+}
+
+static void test_save_load_round_trip() {
+    recordSession();
+    uint16_t recorded = InputTrc.getCount();
+
+    TEST_ASSERT_TRUE(InputTrc.save(TRACE_FILE));
+    InputTrc.startRecording();                  // Clears the trace
+    TEST_ASSERT_EQUAL(0, InputTrc.getCount());
+    TEST_ASSERT_TRUE(InputTrc.load(TRACE_FILE));
+    TEST_ASSERT_EQUAL(recorded, InputTrc.getCount());
+
+    TEST_ASSERT_FALSE(InputTrc.load("missing_" TRACE_FILE));
+}
+
+static void test_realtime_replay_matches_recording() {
+    uint32_t recordStartMs = recordSession();
+    std::vector<Gesture> live = gestures;
+    TEST_ASSERT_TRUE(InputTrc.save(TRACE_FILE));
+    TEST_ASSERT_TRUE(InputTrc.load(TRACE_FILE));
+
+    gestures.clear();
+    uint32_t replayStartMs = millis();
+    TEST_ASSERT_TRUE(InputTrc.startReplay(TRACE_REPLAY_REALTIME, handleReplayEvent, onReplayDone));
+    runUntil(replayStartMs + SESSION_END_MS);
+
+    TEST_ASSERT_TRUE(replayDone);
+    TEST_ASSERT_FALSE(InputTrc.isReplaying());
+    TEST_ASSERT_EQUAL(SESSION_EVENTS, replayed.size());
+    assertSameGestures(live, gestures);
+
+    // Same timing, shifted to the start of the replay
+    for (size_t i = 0; i < live.size(); i++) {
+        TEST_ASSERT_EQUAL(live[i].timeMs - recordStartMs, gestures[i].timeMs - replayStartMs);
+    }
+}
+
+static void test_fast_replay_keeps_gestures() {
+    recordSession();
+    std::vector<Gesture> live = gestures;
+
+    gestures.clear();
+    uint32_t replayStartMs = millis();
+    TEST_ASSERT_TRUE(InputTrc.startReplay(TRACE_REPLAY_FAST, handleReplayEvent, onReplayDone));
+    while (!replayDone && millis() - replayStartMs < SESSION_END_MS) runUntil(millis() + 1);
+    uint32_t replayMs = millis() - replayStartMs;
+    runUntil(millis() + GESTURE_LONG_PRESS_MS);  // Let a held-back press come out
+
+    TEST_ASSERT_TRUE(replayDone);
+    assertSameGestures(live, gestures);
+    // Idle time is cut, hold times are kept
+    TEST_ASSERT_TRUE(replayMs < 10000);
+}
+
+static void test_stopped_replay_releases_keys() {
+    recordSession();
+
+    uint32_t replayStartMs = millis();
+    TEST_ASSERT_TRUE(InputTrc.startReplay(TRACE_REPLAY_REALTIME, handleReplayEvent, onReplayDone));
+    runUntil(replayStartMs + 3500);             // DOWN is held and repeating
+    TEST_ASSERT_TRUE(replayed.back().key == INPUT_DOWN && replayed.back().pressed);
+
+    InputTrc.stopReplay();
+    TEST_ASSERT_TRUE(replayDone);
+    TEST_ASSERT_EQUAL(INPUT_DOWN, replayed.back().key);
+    TEST_ASSERT_FALSE(replayed.back().pressed);
+
+    // Nothing left running in the gesture engine
+    size_t before = gestures.size();
+    runUntil(millis() + 2000);
+    TEST_ASSERT_EQUAL(before, gestures.size());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_recorded_session_gestures);
+    RUN_TEST(test_save_load_round_trip);
+    RUN_TEST(test_realtime_replay_matches_recording);
+    RUN_TEST(test_fast_replay_keeps_gestures);
+    RUN_TEST(test_stopped_replay_releases_keys);
+    return UNITY_END();
+}